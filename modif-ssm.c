@@ -3,9 +3,41 @@
 #include <string.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SSM_X86 1
+#endif
 
+#ifndef VERBOSE
 #define VERBOSE 1
-#define VERBOSE_RECTANGLE_SEARCH 1
+#endif
+#ifndef VERBOSE_RECTANGLE_SEARCH
+#define VERBOSE_RECTANGLE_SEARCH VERBOSE
+#endif
+#ifndef SSM_TRACE
+#define SSM_TRACE 1
+#endif
+
+/* Log langkah demi langkah (printf) hanya dikompilasi jika VERBOSE, dan bisa dimatikan saat runtime
+ * dengan --quiet. Di-set di main sebelum solver berjalan; hanya cross-check --bench-seeds (satu thread) yang
+ * mematikannya sementara. */
+static bool log_steps = true;
+#define LOG_STEPS (VERBOSE && log_steps)
+#define LOG_RECT_STEPS (VERBOSE_RECTANGLE_SEARCH && log_steps)
 
 // Nilai Optimal per data N01.N35 
 
@@ -28,7 +60,7 @@ static long long total_biaya(int m, int n, int cost[m][n], int alloc[m][n]) {
 
 /* Helper printing utilities */
 static void print_alloc_matrix_int(int m, int n, int alloc[m][n]) {
-    if (!VERBOSE) return;
+    if (!LOG_STEPS) return;
     printf("\n+---------------------- ALLOCATION MATRIX (%dx%d) ----------------------+\n", m, n);
     // header kolom (1-based)
     printf("        ");
@@ -43,7 +75,7 @@ static void print_alloc_matrix_int(int m, int n, int alloc[m][n]) {
 }
 
 static void print_cost_matrix(int m, int n, int cost[m][n], int demand[n], int supply[m]) {
-    if (!VERBOSE) return;
+    if (!LOG_STEPS) return;
     printf("\n+------------------------- COST MATRIX (%dx%d) -------------------------+\n", m, n);
     printf("        ");
     for (int j = 0; j < n; j++) printf("  c%02d  ", j+1);
@@ -64,21 +96,21 @@ static void print_cost_matrix(int m, int n, int cost[m][n], int demand[n], int s
 }
 
 static void print_array_ll(const char *name, int len, long long arr[]) {
-    if (!VERBOSE) return;
+    if (!LOG_STEPS) return;
     printf("%s: [", name);
     for (int i = 0; i < len; i++) printf("%lld%s", arr[i], (i == len-1) ? "" : ", ");
     printf("]\n");
 }
 
 static void print_array_int(const char *name, int len, int arr[]) {
-    if (!VERBOSE) return;
+    if (!LOG_STEPS) return;
     printf("%s: [", name);
     for (int i = 0; i < len; i++) printf("%d%s", arr[i], (i == len-1) ? "" : ", ");
     printf("]\n");
 }
 
 static void print_supply_status(int m, int supply[], int total_alloc_baris[]) {
-    if (!VERBOSE) return;
+    if (!LOG_STEPS) return;
     printf("\nSupply status (supply / alokasi / sisa):\n");
     printf("------------------------------------------------\n");
     printf("  Row | Supply |  Alokasi  | Sisa\n");
@@ -90,436 +122,5804 @@ static void print_supply_status(int m, int supply[], int total_alloc_baris[]) {
     printf("------------------------------------------------\n");
 }
 
-// Fase optimisasi: perbaikan rectangular (4-sudut) yang di-looping terus-menerus
+/* ==================== Trace dan metrik ==================== */
 
-static void improve_with_rectangles(int m, int n, int cost[m][n], int alloc[m][n]) {
-    int iter = 0;
+/* Event trace biner: record berukuran tetap ditulis ke buffer yang dialokasikan di awal, bukan ke stdio.
+ * Mode file: buffer di-flush (write) ke file setiap penuh. Mode ring: hanya N record terakhir disimpan dan
+ * ditulis saat trace ditutup. SSM_TRACE=0 saat compile membuat TRACE() hilang sama sekali. */
+typedef enum {
+    TR_INSTANCE = 1, // m, n
+    TR_PHASE_BEGIN,  // fase (TracePhase)
+    TR_PHASE_END,    // fase, cost setelah fase (32 bit bawah / atas)
+    TR_FEAS_MOVE,    // iterasi, kolom, flc, slc, jumlah dipindah, jumlah_ER
+    TR_RECT_MOVE,    // iterasi, r1, c1, r2, c2, delta, theta, tipe2
+    TR_NS_PIVOT,     // pivot ke-, baris masuk, kolom masuk
+    TR_EVENT_COUNT
+} TraceEvent;
 
-    if (VERBOSE) {
-        printf("\n=== RECTANGLE IMPROVEMENT PHASE: START ===\n");
-        print_alloc_matrix_int(m, n, alloc);
-    }
-    
-    // Loop utama yang akan terus berjalan selama perbaikan masih ditemukan
-    while (true) {
-        int best_r1 = -1, best_c1 = -1, best_r2 = -1, best_c2 = -1;
-        int best_delta = 0;
-        bool is_type2_move = false; // Flag untuk menandai tipe perbaikan
-        
-        int rect_counter = 0; // Menghitung jumlah rectangle yang dicek per iterasi
-        if (VERBOSE_RECTANGLE_SEARCH) {
-            printf("\n[Pencarian Iterasi %d] Memeriksa semua kemungkinan rectangle...\n", iter + 1);
-        }
-
-        // Cari perbaikan terbaik di seluruh tabel
-        for (int r1 = 0; r1 < m; r1++) {
-            for (int c1 = 0; c1 < n; c1++) {
-                for (int r2 = r1 + 1; r2 < m; r2++) {
-                    for (int c2 = c1 + 1; c2 < n; c2++) {
-                        
-                        rect_counter++;
-                        if (VERBOSE_RECTANGLE_SEARCH) {
-                            printf("---\n[rect-%03d] Cek (r%d,c%d)-(r%d,c%d)\n", 
-                                   rect_counter, r1+1, c1+1, r2+1, c2+1);
-                        }
+typedef enum { PHASE_SEED = 0, PHASE_RECT, PHASE_EXACT } TracePhase;
 
-                        // Tipe 1: Pindahkan alokasi DARI (r1,c1) & (r2,c2)
-                        // Donors: (r1,c1) , (r2,c2)
-                        // Penerima: (r1,c2) , (r2,c1)
-                        int delta1 = (cost[r1][c2] + cost[r2][c1]) - (cost[r1][c1] + cost[r2][c2]);
-                        
-                        // Cek Alokasi Donor Tipe 1
-                        if (alloc[r1][c1] > 0 && alloc[r2][c2] > 0) {
-                            if (VERBOSE_RECTANGLE_SEARCH) {
-                                printf("    [T1] Cek donor (r%d,c%d)=%d, (r%d,c%d)=%d. OK.\n",
-                                       r1+1, c1+1, alloc[r1][c1], r2+1, c2+1, alloc[r2][c2]);
-                                printf("    [T1] Delta = (cost[r%d][c%d] + cost[r%d][c%d]) - (cost[r%d][c%d] + cost[r%d][c%d])\n",
-                                       r1+1, c2+1, r2+1, c1+1, r1+1, c1+1, r2+1, c2+1);
-                                printf("    [T1] Delta = (%d + %d) - (%d + %d) = %d\n",
-                                       cost[r1][c2], cost[r2][c1], cost[r1][c1], cost[r2][c2], delta1);
-                            }
-                            if (delta1 < best_delta) {
-                                best_delta = delta1;
-                                best_r1 = r1; best_c1 = c1;
-                                best_r2 = r2; best_c2 = c2;
-                                is_type2_move = false;
-                                if (VERBOSE) {
-                                    printf("    [T1] => Perbaikan T1 ditemukan! Delta baru = %d.\n", delta1);
-                                }
-                            } else if (VERBOSE_RECTANGLE_SEARCH) {
-                                printf("    [T1] Skip: delta %d >= best_delta %d.\n", delta1, best_delta);
-                            }
-                        } else if (VERBOSE_RECTANGLE_SEARCH) {
-                            printf("    [T1] Skip: donor (r%d,c%d)=%d atau (r%d,c%d)=%d adalah 0.\n",
-                                   r1+1, c1+1, alloc[r1][c1], r2+1, c2+1, alloc[r2][c2]);
-                        }
+static const char *const trace_phase_names[] = { "seed", "rect", "exact" };
 
+static const char *const trace_event_names[TR_EVENT_COUNT] = {
+    "?", "instance", "phase_begin", "phase_end", "feas_move", "rect_move", "ns_pivot"
+};
 
-                        // Tipe 2: Pindahkan alokasi DARI (r1,c2) & (r2,c1)
-                        // Donors: (r1,c2) , (r2,c1)
-                        // Penerima: (r1,c1) , (r2,c2)
-                        int delta2 = (cost[r1][c1] + cost[r2][c2]) - (cost[r1][c2] + cost[r2][c1]);
-
-                        // Cek Alokasi Donor Tipe 2
-                        if (alloc[r1][c2] > 0 && alloc[r2][c1] > 0) {
-                             if (VERBOSE_RECTANGLE_SEARCH) {
-                                printf("    [T2] Cek donor (r%d,c%d)=%d, (r%d,c%d)=%d. OK.\n",
-                                       r1+1, c2+1, alloc[r1][c2], r2+1, c1+1, alloc[r2][c1]);
-                                printf("    [T2] Delta = (cost[r%d][c%d] + cost[r%d][c%d]) - (cost[r%d][c%d] + cost[r%d][c%d])\n",
-                                       r1+1, c1+1, r2+1, c2+1, r1+1, c2+1, r2+1, c1+1);
-                                printf("    [T2] Delta = (%d + %d) - (%d + %d) = %d\n",
-                                       cost[r1][c1], cost[r2][c2], cost[r1][c2], cost[r2][c1], delta2);
-                            }
-                            if (delta2 < best_delta) {
-                                best_delta = delta2;
-                                best_r1 = r1; best_c1 = c1;
-                                best_r2 = r2; best_c2 = c2;
-                                is_type2_move = true;
-                                if (VERBOSE) {
-                                    printf("    [T2] => Perbaikan T2 ditemukan! Delta baru = %d.\n", delta2);
-                                }
-                            } else if (VERBOSE_RECTANGLE_SEARCH) {
-                                printf("    [T2] Skip: delta %d >= best_delta %d.\n", delta2, best_delta);
-                            }
-                        } else if (VERBOSE_RECTANGLE_SEARCH) {
-                            printf("    [T2] Skip: donor (r%d,c%d)=%d atau (r%d,c%d)=%d adalah 0.\n",
-                                   r1+1, c2+1, alloc[r1][c2], r2+1, c1+1, alloc[r2][c1]);
-                        }
-                    }
-                }
-            }
-        }
-        
-        if (VERBOSE_RECTANGLE_SEARCH) {
-             printf("---\n[Pencarian Selesai] Total %d rectangle dicek. Best delta ditemukan: %d\n", rect_counter, best_delta);
-        }
+typedef struct {
+    uint64_t t_ns;       // relatif terhadap pembukaan trace
+    uint32_t ev;
+    int32_t v[8];
+    uint32_t pad;
+} TraceRecord;
 
-        // Jika setelah dicek semua kemungkinan tidak ada delta negatif, optimasi selesai.
-        if (best_delta >= 0) {
-            if (VERBOSE) printf("\nTidak ditemukan rectangle yang memperbaiki (best_delta=%d). Optimisasi rectangle selesai.\n", best_delta);
-            break; // Keluar dari loop while(true)
-        }
-        
-        iter++;
-        int r1 = best_r1, c1 = best_c1, r2 = best_r2, c2 = best_c2;
-        int theta;
-
-        if (VERBOSE) {
-            printf("\n--- Perbaikan iterasi %d ---\n", iter);
-            printf(" Koordinat rectangle: (r%d,c%d), (r%d,c%d)  |  tipe perbaikan: %s  |  delta=%d\n",
-                   r1+1, c1+1, r2+1, c2+1, is_type2_move ? "Tipe 2" : "Tipe 1", best_delta);
-            printf(" Nilai sebelum: (r%d,c%d)=%d, (r%d,c%d)=%d, (r%d,c%d)=%d, (r%d,c%d)=%d\n",
-                   r1+1, c1+1, alloc[r1][c1], r1+1, c2+1, alloc[r1][c2], r2+1, c1+1, alloc[r2][c1], r2+1, c2+1, alloc[r2][c2]);
-        }
-
-        // Lakukan update alokasi berdasarkan tipe perbaikan yang ditemukan
-        if (!is_type2_move) {
-            // Tipe 1: Kurangi dari (r1,c1) & (r2,c2)
-            theta = alloc[r1][c1] < alloc[r2][c2] ? alloc[r1][c1] : alloc[r2][c2];
-            
-            if (VERBOSE) {
-                printf(" Tentukan theta (T1): min(alloc[r%d][c%d], alloc[r%d][c%d]) = min(%d, %d) = %d\n",
-                       r1+1, c1+1, r2+1, c2+1, alloc[r1][c1], alloc[r2][c2], theta);
-                printf(" Pergeseran (theta=%d):\n", theta);
-                printf("  (r%d,c%d) [penerima] = %d + %d = %d\n", r1+1, c2+1, alloc[r1][c2], theta, alloc[r1][c2] + theta);
-                printf("  (r%d,c%d) [penerima] = %d + %d = %d\n", r2+1, c1+1, alloc[r2][c1], theta, alloc[r2][c1] + theta);
-                printf("  (r%d,c%d) [donor]    = %d - %d = %d\n", r1+1, c1+1, alloc[r1][c1], theta, alloc[r1][c1] - theta);
-                printf("  (r%d,c%d) [donor]    = %d - %d = %d\n", r2+1, c2+1, alloc[r2][c2], theta, alloc[r2][c2] - theta);
-            }
-            if (theta <= 0) continue; 
-
-            alloc[r1][c2] += theta;
-            alloc[r2][c1] += theta;
-            alloc[r1][c1] -= theta;
-            alloc[r2][c2] -= theta;
+#define TRACE_MAGIC "SSMT"
+#define TRACE_VERSION 1u
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t reserved;
+} TraceFileHeader;
+
+typedef struct {
+    TraceRecord *buf;
+    size_t cap, len;     // len = isi buffer (mode file)
+    uint64_t emitted;    // total record yang pernah di-emit
+    uint64_t t0;
+    int fd;
+    bool ring;
+    bool write_failed;   // ada write yang gagal (disk penuh, dsb.): record berikutnya dibuang, dilaporkan saat close
+} TraceSink;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static bool trace_write_all(int fd, const void *p, size_t bytes) {
+    const unsigned char *c = p;
+    while (bytes > 0) {
+        ssize_t w = write(fd, c, bytes);
+        if (w <= 0) return false;
+        c += w;
+        bytes -= (size_t)w;
+    }
+    return true;
+}
+
+/* Buka trace ke path. ring_records > 0: mode ring dengan kapasitas tersebut, selain itu mode file. */
+static bool trace_open(TraceSink *t, const char *path, size_t ring_records) {
+    memset(t, 0, sizeof *t);
+    t->ring = ring_records > 0;
+    t->cap = t->ring ? ring_records : 4096;
+    t->buf = malloc(t->cap * sizeof(TraceRecord));
+    t->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (t->buf == NULL || t->fd < 0) {
+        free(t->buf);
+        if (t->fd >= 0) close(t->fd);
+        return false;
+    }
+    TraceFileHeader h = { { 'S', 'S', 'M', 'T' }, TRACE_VERSION, (uint32_t)sizeof(TraceRecord), 0 };
+    t->write_failed = !trace_write_all(t->fd, &h, sizeof h);
+    t->t0 = now_ns();
+    return true;
+}
+
+#if SSM_TRACE
+static void trace_emit(TraceSink *t, TraceEvent ev, const int32_t v[8]) {
+    TraceRecord *r = t->ring ? &t->buf[t->emitted % t->cap] : &t->buf[t->len++];
+    r->t_ns = now_ns() - t->t0;
+    r->ev = (uint32_t)ev;
+    memcpy(r->v, v, sizeof r->v);
+    r->pad = 0;
+    t->emitted++;
+    if (!t->ring && t->len == t->cap) {
+        if (!t->write_failed && !trace_write_all(t->fd, t->buf, t->len * sizeof(TraceRecord))) t->write_failed = true;
+        t->len = 0;
+    }
+}
+#endif
+
+/* Kembalikan false jika ada bagian trace yang gagal ditulis (file trace tidak lengkap) */
+static bool trace_close(TraceSink *t) {
+    if (t->buf == NULL) return true;
+    bool ok = !t->write_failed;
+    if (t->ring) {
+        // Tulis isi ring dalam urutan kronologis: record tertua ada di posisi emitted % cap
+        if (t->emitted <= t->cap) {
+            ok = ok && trace_write_all(t->fd, t->buf, (size_t)t->emitted * sizeof(TraceRecord));
         } else {
-            // Tipe 2: Kurangi dari (r1,c2) & (r2,c1)
-            theta = alloc[r1][c2] < alloc[r2][c1] ? alloc[r1][c2] : alloc[r2][c1];
-            
-             if (VERBOSE) {
-                 printf(" Tentukan theta (T2): min(alloc[r%d][c%d], alloc[r%d][c%d]) = min(%d, %d) = %d\n",
-                       r1+1, c2+1, r2+1, c1+1, alloc[r1][c2], alloc[r2][c1], theta);
-                printf(" Pergeseran (theta=%d):\n", theta);
-                printf("  (r%d,c%d) [penerima] = %d + %d = %d\n", r1+1, c1+1, alloc[r1][c1], theta, alloc[r1][c1] + theta);
-                printf("  (r%d,c%d) [penerima] = %d + %d = %d\n", r2+1, c2+1, alloc[r2][c2], theta, alloc[r2][c2] + theta);
-                printf("  (r%d,c%d) [donor]    = %d - %d = %d\n", r1+1, c2+1, alloc[r1][c2], theta, alloc[r1][c2] - theta);
-                printf("  (r%d,c%d) [donor]    = %d - %d = %d\n", r2+1, c1+1, alloc[r2][c1], theta, alloc[r2][c1] - theta);
-            }
-            if (theta <= 0) continue; 
-
-            alloc[r1][c1] += theta;
-            alloc[r2][c2] += theta;
-            alloc[r1][c2] -= theta;
-            alloc[r2][c1] -= theta;
-        }
-
-        if (VERBOSE) {
-            printf(" Nilai setelah:  (r%d,c%d)=%d, (r%d,c%d)=%d, (r%d,c%d)=%d, (r%d,c%d)=%d\n",
-                   r1+1, c1+1, alloc[r1][c1], r1+1, c2+1, alloc[r1][c2], r2+1, c1+1, alloc[r2][c1], r2+1, c2+1, alloc[r2][c2]);
-            long long tot = total_biaya(m, n, cost, alloc);
-            printf(" Total cost setelah pembaruan = %lld\n", tot);
-            print_alloc_matrix_int(m, n, alloc);
+            size_t first = (size_t)(t->emitted % t->cap);
+            ok = ok && trace_write_all(t->fd, t->buf + first, (t->cap - first) * sizeof(TraceRecord));
+            ok = ok && trace_write_all(t->fd, t->buf, first * sizeof(TraceRecord));
         }
+    } else if (t->len > 0) {
+        ok = ok && trace_write_all(t->fd, t->buf, t->len * sizeof(TraceRecord));
     }
+    if (close(t->fd) != 0) ok = false;
+    free(t->buf);
+    memset(t, 0, sizeof *t);
+    return ok;
+}
 
-    if (VERBOSE) {
-        printf("\n[RECTANGLE SUMMARY] Total perbaikan rectangle yang diterapkan: %d iterasi.\n", iter);
-        printf("=== RECTANGLE IMPROVEMENT PHASE: END ===\n");
+#if SSM_TRACE
+#define TRACE(sink, ev, ...) do { \
+        if ((sink) != NULL) trace_emit((sink), (ev), (const int32_t[8]){ __VA_ARGS__ }); \
+    } while (0)
+#else
+#define TRACE(sink, ev, ...) ((void)0)
+#endif
+
+/* Cetak file trace biner sebagai teks (satu record per baris) */
+static int trace_dump(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("Gagal membuka trace %s\n", path);
+        return 1;
+    }
+    TraceFileHeader h;
+    if (read(fd, &h, sizeof h) != (ssize_t)sizeof h || memcmp(h.magic, TRACE_MAGIC, 4) != 0 ||
+        h.version != TRACE_VERSION || h.record_size != sizeof(TraceRecord)) {
+        printf("%s bukan file trace yang valid.\n", path);
+        close(fd);
+        return 1;
+    }
+    TraceRecord r;
+    long long count = 0;
+    while (read(fd, &r, sizeof r) == (ssize_t)sizeof r) {
+        printf("%14.3f us  %-12s", (double)r.t_ns / 1e3, r.ev < TR_EVENT_COUNT ? trace_event_names[r.ev] : "?");
+        for (int k = 0; k < 8; k++) printf(" %d", r.v[k]);
+        printf("\n");
+        count++;
     }
+    printf("Total record: %lld\n", count);
+    close(fd);
+    return 0;
 }
 
-static void make_feasible_ssm(int m, int n, int cost[m][n], int supply[m], int demand[n], int alloc[m][n]) {
-    for (int i = 0; i < m; i++)
-        for (int j = 0; j < n; j++)
-            alloc[i][j] = 0;
+/* Counter per fase, selalu aktif (murah: hanya penjumlahan per iterasi/move) */
+typedef struct {
+    long long feas_iters;      // iterasi loop feasibility SSM
+    long long rect_evaluated;  // kandidat rectangle yang diperiksa (lihat improve_with_rectangles)
+    long long rect_moves;      // move rectangle yang diterapkan
+    long long theta_moved;     // total theta yang dipindahkan oleh move rectangle
+    long long ns_pivots;       // pivot network simplex
+    uint64_t seed_ns, rect_ns, exact_ns;
+    long long seed_cost, final_cost;
+    bool early_stop;           // dihentikan oleh batas waktu/kerja, alokasi = terbaik sejauh ini
+    int stop_phase;            // TracePhase tempat solve dihentikan (hanya jika early_stop)
+    bool has_bound;            // lower_bound valid (total supply >= total demand)
+    long long lower_bound;     // bound dual terbaik sejauh ini (lihat dual_lower_bound)
+    long long phase_gap[3];    // cost - lower_bound setelah tiap TracePhase, -1 jika fase tidak jalan
+    bool gap_closed;           // fase rectangle berhenti karena cost == lower_bound
+} SsmMetrics;
 
-    // Inisialisasi awal: isi demand ke baris biaya terendah per kolom
-    for (int j = 0; j < n; j++) {
-        int rmin = 0;
-        for (int i = 1; i < m; i++) if (cost[rmin][j] > cost[i][j]) rmin = i;
-        alloc[rmin][j] = demand[j];
-        if (VERBOSE) printf("[init] kolom c%02d -> pilih baris r%02d (cost=%d) : alokasikan %d\n",
-                           j+1, rmin+1, cost[rmin][j], demand[j]);
+/* Batas waktu dan/atau kerja untuk solve anytime. Loop pencarian memanggil deadline_tick() dengan jumlah unit
+ * kerja yang baru dikerjakan (kurang lebih jumlah sel yang diperiksa); jam hanya dibaca setiap
+ * DEADLINE_CHECK_EVERY unit, jadi jalur cepatnya cuma satu penjumlahan dan satu perbandingan. */
+#define DEADLINE_CHECK_EVERY 4096
+
+/* Incumbent bersama mode portfolio (lihat solve_portfolio). Varian yang sedang jalan membacanya di
+ * deadline_check: berhenti jika incumbent sudah <= lower bound (optimal terbukti), atau jika cost-nya sendiri
+ * masih di atas incumbent padahal kerjanya sudah >= 2x kerja varian incumbent (terdominasi). */
+typedef struct {
+    pthread_mutex_t lock;    // cost dan work selalu ditulis dan dibaca bersama di bawah lock
+    long long cost;          // cost final terbaik dari varian yang sudah selesai, LLONG_MAX = belum ada
+    long long work;          // unit kerja yang dipakai varian incumbent
+    _Atomic long long bound; // lower bound dual terbaik dari varian mana pun, LLONG_MIN = belum ada
+} SsmIncumbent;
+
+typedef struct {
+    uint64_t deadline_ns;  // waktu absolut (now_ns), 0 = tanpa batas waktu
+    long long budget;      // batas unit kerja, 0 = tanpa batas
+    long long work;        // unit kerja terpakai sejak deadline_arm
+    long long next_check;  // deadline_check dipanggil lagi saat work mencapai nilai ini
+    bool expired;
+    SsmIncumbent *incumbent; // != NULL: ikut berhenti saat terdominasi (di-set pemanggil, dipertahankan arm)
+    bool dominance;          // boleh dihentikan oleh aturan dominasi (varian 0 portfolio tidak)
+    long long cur_cost;      // cost solusi berjalan yang dipublikasikan loop rectangle, LLONG_MAX = belum ada
+    bool dominated;          // expired karena incumbent, bukan karena waktu/budget
+} SsmDeadline;
+
+static void deadline_arm(SsmDeadline *d, double time_limit_ms, long long budget) {
+    d->deadline_ns = time_limit_ms > 0 ? now_ns() + (uint64_t)(time_limit_ms * 1e6) : 0;
+    d->budget = budget > 0 ? budget : 0;
+    d->work = 0;
+    d->expired = false;
+    d->cur_cost = LLONG_MAX;
+    d->dominated = false;
+    d->next_check = d->deadline_ns == 0 && d->budget == 0 && !d->incumbent ? LLONG_MAX : 0;
+}
+
+// Dipanggil dari deadline_check (paling sering sekali per DEADLINE_CHECK_EVERY unit), jadi lock-nya murah
+static bool incumbent_dominates(const SsmDeadline *d) {
+    SsmIncumbent *inc = d->incumbent;
+    pthread_mutex_lock(&inc->lock);
+    long long best = inc->cost, best_work = inc->work;
+    pthread_mutex_unlock(&inc->lock);
+    if (best == LLONG_MAX) return false;
+    if (best <= atomic_load_explicit(&inc->bound, memory_order_relaxed)) return true;
+    return d->dominance && d->cur_cost > best && d->work >= 2 * best_work;
+}
+
+static bool deadline_check(SsmDeadline *d) {
+    if (!d->expired) {
+        d->expired = (d->budget > 0 && d->work >= d->budget) || (d->deadline_ns != 0 && now_ns() >= d->deadline_ns);
+        if (!d->expired && d->incumbent && incumbent_dominates(d)) d->expired = d->dominated = true;
+        d->next_check = d->work + DEADLINE_CHECK_EVERY;
+        if (d->budget > 0 && d->next_check > d->budget) d->next_check = d->budget;
     }
+    if (d->expired) d->next_check = LLONG_MIN; // sticky: setiap tick berikutnya langsung true
+    return d->expired;
+}
 
-    int total_alloc_baris[m];
-    int arr[m], satisfy[m];
-    int flc[n], slc[n], diff[n], konflik[n];
-    int itertemp = 0, jumlah_ER, coorselisih;
-    const int MAX_FEAS_ITERS = 2000;
+static bool deadline_tick(SsmDeadline *d, long long units) {
+    d->work += units;
+    return d->work >= d->next_check && deadline_check(d);
+}
 
-    while (1) {
-        jumlah_ER = 0;
-        for (int i = 0; i < m; i++) {
-            arr[i] = 0;
-            satisfy[i] = 0;
-            total_alloc_baris[i] = 0;
-            for (int j = 0; j < n; j++) total_alloc_baris[i] += alloc[i][j];
-            if (total_alloc_baris[i] > supply[i]) { arr[i] = 1; jumlah_ER++; }
-            else if (total_alloc_baris[i] == supply[i]) { satisfy[i] = 1; }
-        }
+// Fase optimisasi: perbaikan rectangular (4-sudut) yang di-looping terus-menerus
 
-        if (VERBOSE) {
-            printf("\n=== SSM FEASIBILITY ITER %d ===\n", itertemp);
-            printf("Keterangan: ER = over-supplied row, S = satisfied, NS = not-satisfied\n");
-            for (int i = 0; i < m; i++) {
-                for (int j = 0; j < n; j++) printf("%4d[%3d] ", cost[i][j], alloc[i][j]);
-                printf(" | S=%6d TA=%6d", supply[i], total_alloc_baris[i]);
-                if (arr[i]) printf("  <-- ER");
-                else if (satisfy[i]) printf("  <-- S");
-                else printf("  <-- NS");
-                printf("\n");
-            }
-            printf("---------------------------------------------------------------------\n");
-            print_supply_status(m, supply, total_alloc_baris);
-        }
+/* Mode pencarian rectangle terbaik per iterasi */
+typedef enum {
+    RECT_SEARCH_EXHAUSTIVE = 0, // scan penuh O(m^2 n^2) setiap iterasi (referensi)
+    RECT_SEARCH_SCAN,           // kernel scan per pasangan baris, O(m^2 n) setiap iterasi
+    RECT_SEARCH_INCREMENTAL,    // cache kandidat per pasangan baris, re-check hanya baris yang berubah
+    RECT_SEARCH_SPARSE,         // enumerasi pasangan sel donor dari daftar sel positif, O(B^2)
+    RECT_SEARCH_VERIFY          // kernel scan + cek silang dengan loop brute-force per pasangan baris
+} RectSearchMode;
 
-        if (jumlah_ER == 0) break;
-        itertemp++;
-        if (itertemp >= MAX_FEAS_ITERS) {
-            printf("Peringatan: Iterasi Feasibility mencapai batas maksimum (%d)!\n", MAX_FEAS_ITERS);
-            break;
-        }
+static const char *const rect_mode_names[] = { "exhaustive", "scan", "incremental", "sparse", "verify" };
 
-        // Tentukan kolom konflik (kolom yang memiliki alokasi pada row ER)
-        for (int j = 0; j < n; j++) {
-            konflik[j] = 0;
-            for (int i = 0; i < m; i++) if (alloc[i][j] > 0 && arr[i] == 1) { konflik[j] = 1; break; }
-        }
+typedef enum {
+    FEAS_SCAN_SORTED = 0, // slc dari urutan cost per kolom + cursor (sort sekali per matriks cost)
+    FEAS_SCAN_SIMD        // slc dari scan argmin ber-mask (SIMD) atas salinan cost kolom-mayor
+} FeasScanMode;
 
-        // Tentukan flc (first conflicting row) per kolom
-        for (int j = 0; j < n; j++) {
-            if (!konflik[j]) { flc[j] = -1; continue; }
-            flc[j] = -1;
-            for (int i = 0; i < m; i++) if (alloc[i][j] > 0 && arr[i] == 1) { flc[j] = i; break; }
-        }
+typedef enum {
+    SEED_SSM = 0,    // demand ke baris termurah per kolom + perbaikan feasibility SSM
+    SEED_LEAST_COST, // matrix least-cost (sel diurutkan sekali)
+    SEED_VOGEL,      // Vogel's approximation (urutan per baris/kolom + heap penalti)
+    SEED_RUSSELL     // Russell (lazy min-heap, kunci hanya bisa naik)
+} SeedStrategy;
 
-        // Tentukan slc (second candidate row) per kolom: row dengan cost terendah yang bukan ER dan bukan SATISFY
-        for (int j = 0; j < n; j++) {
-            if (!konflik[j]) { slc[j] = -1; continue; }
-            slc[j] = -1;
-            int best = INT_MAX;
-            for (int i = 0; i < m; i++) {
-                if (arr[i] != 1 && satisfy[i] != 1) {
-                    if (cost[i][j] < best) { best = cost[i][j]; slc[j] = i; }
-                }
+/* Aturan flc per kolom konflik pada feasibility SSM */
+typedef enum {
+    FLC_FIRST = 0,  // baris ER pertama (indeks terkecil) yang punya alokasi di kolom
+    FLC_COSTLIEST   // baris ER dengan cost terbesar di kolom (tie: indeks terkecil)
+} FlcRule;
+
+static const char *const flc_rule_names[] = { "first", "costliest" };
+
+/* Aturan pivot fase rectangle untuk --rect=scan|verify (mode lain selalu best-improvement) */
+typedef enum {
+    PIVOT_BEST = 0, // best-improvement: semua pasangan baris discan untuk satu move
+    PIVOT_FIRST,    // first-improvement: pasangan pertama yang memperbaiki, titik awal berputar
+    PIVOT_LIST,     // daftar top-k pasangan dari satu scan penuh, divalidasi ulang setelah setiap move
+    PIVOT_BLOCK     // partial pricing: best-improvement per blok pasangan baris, blok berputar
+} RectPivotRule;
+
+static const char *const pivot_rule_names[] = { "best", "first", "list", "block" };
+
+#define PIVOT_LIST_DEFAULT_K 32 // panjang daftar kandidat PIVOT_LIST jika pivot_k = 0
+
+typedef struct {
+    RectSearchMode rect_mode;
+    int threads; // jumlah thread untuk pencarian scan (1 = serial)
+    bool exact;  // jalankan fase network simplex setelah rectangle
+    FeasScanMode feas_scan;
+    SeedStrategy seed; // solusi awal sebelum fase rectangle
+    double time_limit_ms;   // batas waktu per solve_instance (0 = tanpa batas)
+    long long work_budget;  // batas unit kerja per solve_instance (0 = tanpa batas)
+    FlcRule flc_rule;       // pemilihan flc pada feasibility SSM
+    RectPivotRule pivot;    // aturan pivot fase rectangle (mode scan/verify, serial)
+    int pivot_k;            // PIVOT_LIST: panjang daftar (0 = PIVOT_LIST_DEFAULT_K)
+    int pivot_block;        // PIVOT_BLOCK: pasangan baris per blok (0 = m)
+    uint64_t tie_seed;      // != 0: tie diff/slc/init pada feasibility SSM diputus acak (deterministik per seed)
+} SsmOptions;
+
+static const SsmOptions default_options = { .rect_mode = RECT_SEARCH_SCAN, .threads = 1, .exact = false,
+                                            .feas_scan = FEAS_SCAN_SORTED, .seed = SEED_SSM };
+
+// Aturan pivot yang benar-benar dipakai: hanya mode scan/verify yang punya jendela scan per pasangan baris
+static RectPivotRule rect_pivot_rule(const SsmOptions *opt) {
+    bool scan = opt->rect_mode == RECT_SEARCH_SCAN || opt->rect_mode == RECT_SEARCH_VERIFY;
+    return scan ? opt->pivot : PIVOT_BEST;
+}
+
+static int rect_pivot_list_cap(const SsmOptions *opt) {
+    if (rect_pivot_rule(opt) != PIVOT_LIST) return 0;
+    return opt->pivot_k > 0 ? opt->pivot_k : PIVOT_LIST_DEFAULT_K;
+}
+
+/* Satu kandidat perbaikan rectangle. delta < 0 berarti memperbaiki, r1 = -1 berarti kosong */
+typedef struct {
+    int delta;
+    int r1, c1, r2, c2;
+    bool type2;
+} RectMove;
+
+static const RectMove no_rect_move = { 0, -1, -1, -1, -1, false };
+
+/* Urutan kandidat sama dengan scan penuh: delta terkecil, lalu (r1, c1, r2, c2) terkecil, T1 sebelum T2 */
+static bool rect_move_better(const RectMove *a, const RectMove *b) {
+    if (a->r1 < 0) return false;
+    if (b->r1 < 0) return true;
+    if (a->delta != b->delta) return a->delta < b->delta;
+    if (a->r1 != b->r1) return a->r1 < b->r1;
+    if (a->c1 != b->c1) return a->c1 < b->c1;
+    if (a->r2 != b->r2) return a->r2 < b->r2;
+    if (a->c2 != b->c2) return a->c2 < b->c2;
+    return !a->type2 && b->type2;
+}
+
+/* Kandidat terbaik untuk satu pasangan baris (r1 < r2), urutan (c1, c2, tipe) sama dengan scan penuh.
+ * Versi brute-force O(n^2), dipakai sebagai referensi untuk kernel scan. */
+static int rect_best_for_pair_brute(int m, int n, int cost[m][n], int alloc[m][n], int r1, int r2, RectMove *out) {
+    *out = no_rect_move;
+    int best_delta = 0, evaluated = 0;
+    for (int c1 = 0; c1 < n; c1++) {
+        for (int c2 = c1 + 1; c2 < n; c2++) {
+            evaluated++;
+            int delta1 = (cost[r1][c2] + cost[r2][c1]) - (cost[r1][c1] + cost[r2][c2]);
+            if (alloc[r1][c1] > 0 && alloc[r2][c2] > 0 && delta1 < best_delta) {
+                best_delta = delta1;
+                *out = (RectMove){ delta1, r1, c1, r2, c2, false };
+            }
+            int delta2 = -delta1;
+            if (alloc[r1][c2] > 0 && alloc[r2][c1] > 0 && delta2 < best_delta) {
+                best_delta = delta2;
+                *out = (RectMove){ delta2, r1, c1, r2, c2, true };
             }
         }
+    }
+    return evaluated;
+}
 
-        // Hitung diff per kolom (selisih biaya slc - flc)
-        for (int j = 0; j < n; j++) {
-            if (konflik[j] && slc[j] != -1) diff[j] = cost[slc[j]][j] - cost[flc[j]][j];
-            else diff[j] = INT_MAX / 2;
+/* Kernel scan O(n) untuk satu pasangan baris (r1 < r2).
+ * Dengan d[c] = cost[r1][c] - cost[r2][c]: delta T1 = d[c2] - d[c1], delta T2 = d[c1] - d[c2].
+ * Untuk setiap c2 cukup simpan max d[c1] (donor r1 > 0) dan min d[c1] (donor r2 > 0) dari c1 < c2,
+ * dengan index pertama yang mencapainya, sehingga hasilnya sama persis dengan versi brute-force. */
+static int rect_best_for_pair(int m, int n, int cost[m][n], int alloc[m][n], int r1, int r2, RectMove *out) {
+    (void)m;
+    *out = no_rect_move;
+    int max_d = 0, max_c = -1; // max d[c1] dengan alloc[r1][c1] > 0 (donor T1)
+    int min_d = 0, min_c = -1; // min d[c1] dengan alloc[r2][c1] > 0 (donor T2)
+    for (int c = 0; c < n; c++) {
+        int d = cost[r1][c] - cost[r2][c];
+        if (max_c >= 0 && alloc[r2][c] > 0) {
+            RectMove cand = { d - max_d, r1, max_c, r2, c, false };
+            if (cand.delta < 0 && rect_move_better(&cand, out)) *out = cand;
+        }
+        if (min_c >= 0 && alloc[r1][c] > 0) {
+            RectMove cand = { min_d - d, r1, min_c, r2, c, true };
+            if (cand.delta < 0 && rect_move_better(&cand, out)) *out = cand;
         }
+        if (alloc[r1][c] > 0 && (max_c < 0 || d > max_d)) { max_d = d; max_c = c; }
+        if (alloc[r2][c] > 0 && (min_c < 0 || d < min_d)) { min_d = d; min_c = c; }
+    }
+    return n;
+}
 
-        if (VERBOSE) {
-            printf("Summary Kolom Konflik (hanya menampilkan kolom konflik):\n");
-            printf(" col | flc(row,cost) | slc(row,cost) | diff | alokasi_di_flc\n");
-            printf("-----+---------------+----------------+------+--------------\n");
-            for (int j = 0; j < n; j++) {
-                if (konflik[j]) {
-                    printf(" c%02d | r%02d,%4d     | ", j+1, flc[j]+1, cost[flc[j]][j]);
-                    if (slc[j] == -1) printf("   -,-        | ");
-                    else printf(" r%02d,%4d     | ", slc[j]+1, cost[slc[j]][j]);
-                    if (diff[j] >= INT_MAX / 4) printf("  -   | ");
-                    else printf("%4d | ", diff[j]);
-                    printf("%12d\n", (flc[j] == -1) ? 0 : alloc[flc[j]][j]);
-                }
-            }
+/* Index segitiga atas untuk pasangan baris r1 < r2 */
+static size_t row_pair_index(int m, int r1, int r2) {
+    return (size_t)r1 * (size_t)(2 * m - r1 - 1) / 2 + (size_t)(r2 - r1 - 1);
+}
+
+/* Kernel yang sama dengan rect_best_for_pair, tetapi d[c] dibaca dari vektor selisih pasangan yang sudah
+ * dihitung sekali per matriks cost (SsmCostShared.pair_diff): satu load per kolom, bukan dua. */
+static int rect_best_for_pair_diff(int n, const int *d, int alloc[][n], int r1, int r2, RectMove *out) {
+    *out = no_rect_move;
+    int max_d = 0, max_c = -1;
+    int min_d = 0, min_c = -1;
+    for (int c = 0; c < n; c++) {
+        if (max_c >= 0 && alloc[r2][c] > 0) {
+            RectMove cand = { d[c] - max_d, r1, max_c, r2, c, false };
+            if (cand.delta < 0 && rect_move_better(&cand, out)) *out = cand;
         }
+        if (min_c >= 0 && alloc[r1][c] > 0) {
+            RectMove cand = { min_d - d[c], r1, min_c, r2, c, true };
+            if (cand.delta < 0 && rect_move_better(&cand, out)) *out = cand;
+        }
+        if (alloc[r1][c] > 0 && (max_c < 0 || d[c] > max_d)) { max_d = d[c]; max_c = c; }
+        if (alloc[r2][c] > 0 && (min_c < 0 || d[c] < min_d)) { min_d = d[c]; min_c = c; }
+    }
+    return n;
+}
 
-        // Pilih kolom dengan diff minimal (tie-breaker: alokasi lebih besar pada flc)
-        coorselisih = -1;
-        for (int j = 0; j < n; j++) {
-            if (konflik[j] && slc[j] != -1) {
-                if (coorselisih == -1 || diff[j] < diff[coorselisih]) coorselisih = j;
-                else if (diff[j] == diff[coorselisih]) {
-                    if (alloc[flc[j]][j] > alloc[flc[coorselisih]][coorselisih]) coorselisih = j;
+// pair_diff == NULL: selisih dihitung langsung dari cost
+static int rect_pair_best(int m, int n, int cost[m][n], int alloc[m][n], const int *pair_diff, int r1, int r2,
+                          RectMove *out) {
+    if (pair_diff != NULL)
+        return rect_best_for_pair_diff(n, pair_diff + row_pair_index(m, r1, r2) * (size_t)n, alloc, r1, r2, out);
+    return rect_best_for_pair(m, n, cost, alloc, r1, r2, out);
+}
+
+/* Scan penuh seluruh rectangle (referensi, dengan log verbose per rectangle) */
+static RectMove search_rectangles_exhaustive(int m, int n, int cost[m][n], int alloc[m][n], int iter, SsmDeadline *dl) {
+    int best_r1 = -1, best_c1 = -1, best_r2 = -1, best_c2 = -1;
+    int best_delta = 0;
+    bool is_type2_move = false; // Flag untuk menandai tipe perbaikan
+    bool stop = false;          // batas waktu/kerja habis: kembalikan yang terbaik sejauh ini
+
+    int rect_counter = 0; // Menghitung jumlah rectangle yang dicek per iterasi
+    if (LOG_RECT_STEPS) {
+        printf("\n[Pencarian Iterasi %d] Memeriksa semua kemungkinan rectangle...\n", iter + 1);
+    }
+
+    // Cari perbaikan terbaik di seluruh tabel
+    for (int r1 = 0; r1 < m && !stop; r1++) {
+        for (int c1 = 0; c1 < n && !stop; c1++) {
+            for (int r2 = r1 + 1; r2 < m; r2++) {
+                if (deadline_tick(dl, n - c1)) { stop = true; break; }
+                for (int c2 = c1 + 1; c2 < n; c2++) {
+
+                    rect_counter++;
+                    if (LOG_RECT_STEPS) {
+                        printf("---\n[rect-%03d] Cek (r%d,c%d)-(r%d,c%d)\n",
+                               rect_counter, r1+1, c1+1, r2+1, c2+1);
+                    }
+
+                    // Tipe 1: Pindahkan alokasi DARI (r1,c1) & (r2,c2)
+                    // Donors: (r1,c1) , (r2,c2)
+                    // Penerima: (r1,c2) , (r2,c1)
+                    int delta1 = (cost[r1][c2] + cost[r2][c1]) - (cost[r1][c1] + cost[r2][c2]);
+
+                    // Cek Alokasi Donor Tipe 1
+                    if (alloc[r1][c1] > 0 && alloc[r2][c2] > 0) {
+                        if (LOG_RECT_STEPS) {
+                            printf("    [T1] Cek donor (r%d,c%d)=%d, (r%d,c%d)=%d. OK.\n",
+                                   r1+1, c1+1, alloc[r1][c1], r2+1, c2+1, alloc[r2][c2]);
+                            printf("    [T1] Delta = (cost[r%d][c%d] + cost[r%d][c%d]) - (cost[r%d][c%d] + cost[r%d][c%d])\n",
+                                   r1+1, c2+1, r2+1, c1+1, r1+1, c1+1, r2+1, c2+1);
+                            printf("    [T1] Delta = (%d + %d) - (%d + %d) = %d\n",
+                                   cost[r1][c2], cost[r2][c1], cost[r1][c1], cost[r2][c2], delta1);
+                        }
+                        if (delta1 < best_delta) {
+                            best_delta = delta1;
+                            best_r1 = r1; best_c1 = c1;
+                            best_r2 = r2; best_c2 = c2;
+                            is_type2_move = false;
+                            if (LOG_STEPS) {
+                                printf("    [T1] => Perbaikan T1 ditemukan! Delta baru = %d.\n", delta1);
+                            }
+                        } else if (LOG_RECT_STEPS) {
+                            printf("    [T1] Skip: delta %d >= best_delta %d.\n", delta1, best_delta);
+                        }
+                    } else if (LOG_RECT_STEPS) {
+                        printf("    [T1] Skip: donor (r%d,c%d)=%d atau (r%d,c%d)=%d adalah 0.\n",
+                               r1+1, c1+1, alloc[r1][c1], r2+1, c2+1, alloc[r2][c2]);
+                    }
+
+
+                    // Tipe 2: Pindahkan alokasi DARI (r1,c2) & (r2,c1)
+                    // Donors: (r1,c2) , (r2,c1)
+                    // Penerima: (r1,c1) , (r2,c2)
+                    int delta2 = (cost[r1][c1] + cost[r2][c2]) - (cost[r1][c2] + cost[r2][c1]);
+
+                    // Cek Alokasi Donor Tipe 2
+                    if (alloc[r1][c2] > 0 && alloc[r2][c1] > 0) {
+                         if (LOG_RECT_STEPS) {
+                            printf("    [T2] Cek donor (r%d,c%d)=%d, (r%d,c%d)=%d. OK.\n",
+                                   r1+1, c2+1, alloc[r1][c2], r2+1, c1+1, alloc[r2][c1]);
+                            printf("    [T2] Delta = (cost[r%d][c%d] + cost[r%d][c%d]) - (cost[r%d][c%d] + cost[r%d][c%d])\n",
+                                   r1+1, c1+1, r2+1, c2+1, r1+1, c2+1, r2+1, c1+1);
+                            printf("    [T2] Delta = (%d + %d) - (%d + %d) = %d\n",
+                                   cost[r1][c1], cost[r2][c2], cost[r1][c2], cost[r2][c1], delta2);
+                        }
+                        if (delta2 < best_delta) {
+                            best_delta = delta2;
+                            best_r1 = r1; best_c1 = c1;
+                            best_r2 = r2; best_c2 = c2;
+                            is_type2_move = true;
+                            if (LOG_STEPS) {
+                                printf("    [T2] => Perbaikan T2 ditemukan! Delta baru = %d.\n", delta2);
+                            }
+                        } else if (LOG_RECT_STEPS) {
+                            printf("    [T2] Skip: delta %d >= best_delta %d.\n", delta2, best_delta);
+                        }
+                    } else if (LOG_RECT_STEPS) {
+                        printf("    [T2] Skip: donor (r%d,c%d)=%d atau (r%d,c%d)=%d adalah 0.\n",
+                               r1+1, c2+1, alloc[r1][c2], r2+1, c1+1, alloc[r2][c1]);
+                    }
                 }
             }
         }
+    }
 
-        if (coorselisih == -1) {
-            if (VERBOSE) printf("Tidak ditemukan kolom konflik yang dapat dipindahkan pada iterasi ini. Keluar dari loop feasibility.\n");
-            break;
-        }
+    if (LOG_RECT_STEPS) {
+         printf("---\n[Pencarian Selesai] Total %d rectangle dicek. Best delta ditemukan: %d\n", rect_counter, best_delta);
+    }
 
-        int i_flc = flc[coorselisih];
-        int i_slc = slc[coorselisih];
+    RectMove best = { best_delta, best_r1, best_c1, best_r2, best_c2, is_type2_move };
+    return best;
+}
 
-        if (VERBOSE) {
-            printf("-> Kolom terpilih untuk dipindah: c%02d | flc = r%02d | slc = r%02d | diff = %d\n",
-                   coorselisih+1, i_flc+1, i_slc+1, diff[coorselisih]);
-            printf("   Alokasi di flc sebelum pemindahan: %d\n", alloc[i_flc][coorselisih]);
-        }
+/* Kebalikan row_pair_index */
+static void row_pair_from_index(int m, long long p, int *r1, int *r2) {
+    int a = 0;
+    while (p >= m - 1 - a) { p -= m - 1 - a; a++; }
+    *r1 = a;
+    *r2 = a + 1 + (int)p;
+}
 
-        if (supply[i_flc] == supply[i_slc]) {
-            int move = total_alloc_baris[i_flc] - supply[i_flc];
-            if (move < 0) move = alloc[i_flc][coorselisih];
-            if (move > alloc[i_flc][coorselisih]) move = alloc[i_flc][coorselisih];
-            if (VERBOSE) printf("   Case: supply sama. move = %d\n", move);
-            alloc[i_flc][coorselisih] -= move;
-            alloc[i_slc][coorselisih] += move;
-        }
-        else if (jumlah_ER >= 2) {
-            if (supply[i_flc] > supply[i_slc]) {
-                int move = total_alloc_baris[i_flc] - supply[i_flc];
-                if (move > alloc[i_flc][coorselisih]) move = alloc[i_flc][coorselisih];
-                if (VERBOSE) printf("   Case: jumlah_ER>=2 and supply[flc] > supply[slc]. move = %d\n", move);
-                alloc[i_flc][coorselisih] -= move;
-                alloc[i_slc][coorselisih] += move;
-            } else {
-                int alloc_sisa = supply[i_slc] - total_alloc_baris[i_slc];
-                if (VERBOSE) printf("   Case: jumlah_ER>=2 and supply[flc] <= supply[slc]. alloc_sisa = %d\n", alloc_sisa);
-                if (alloc_sisa >= alloc[i_flc][coorselisih]) {
-                    alloc[i_slc][coorselisih] += alloc[i_flc][coorselisih];
-                    alloc[i_flc][coorselisih] = 0;
-                } else {
-                    alloc[i_slc][coorselisih] += alloc_sisa;
-                    alloc[i_flc][coorselisih] -= alloc_sisa;
-                }
-            }
-        } else {
-            if (supply[i_flc] < supply[i_slc]) {
-                int move = total_alloc_baris[i_flc] - supply[i_flc];
-                if (move > alloc[i_flc][coorselisih]) move = alloc[i_flc][coorselisih];
-                if (VERBOSE) printf("   Case: jumlah_ER<2 and supply[flc] < supply[slc]. move = %d\n", move);
-                alloc[i_flc][coorselisih] -= move;
-                alloc[i_slc][coorselisih] += move;
-            } else {
-                int alloc_sisa = supply[i_slc] - total_alloc_baris[i_slc];
-                if (VERBOSE) printf("   Case: jumlah_ER<2 and supply[flc] >= supply[slc]. alloc_sisa = %d\n", alloc_sisa);
-                if (alloc_sisa >= alloc[i_flc][coorselisih]) {
-                    alloc[i_slc][coorselisih] += alloc[i_flc][coorselisih];
-                    alloc[i_flc][coorselisih] = 0;
-                } else {
-                    alloc[i_slc][coorselisih] += alloc_sisa;
-                    alloc[i_flc][coorselisih] -= alloc_sisa;
-                }
+/* Jendela pencarian scan: pasangan baris dicek berurutan (row_pair_index) mulai dari start, berputar. Setelah
+ * setiap `block` pasangan, pencarian berhenti jika sudah ada kandidat yang memperbaiki. start 0 dan
+ * block >= jumlah pasangan = best-improvement biasa; block 1 = first-improvement. */
+typedef struct {
+    long long start;   // masukan: pasangan pertama; keluaran: pasangan sesudah yang terakhir dicek
+    long long block;
+    long long scanned; // keluaran: jumlah pasangan yang dicek
+} RectScanWindow;
+
+/* Best-improvement lewat kernel scan atas jendela pasangan baris, O(m^2 n) untuk satu putaran penuh.
+ * Jika verify = true, setiap pasangan dicek silang dengan versi brute-force.
+ * Jika dl habis di tengah scan, kandidat terbaik dari pasangan yang sudah dicek dikembalikan (tetap valid). */
+static RectMove search_rectangles_scan(int m, int n, int cost[m][n], int alloc[m][n], const int *pair_diff,
+                                       bool verify, RectScanWindow *win, SsmDeadline *dl) {
+    RectMove best = no_rect_move;
+    long long pairs = (long long)m * (m - 1) / 2, p = pairs > 0 ? win->start % pairs : 0;
+    win->scanned = 0;
+    if (pairs == 0) return best;
+    int r1, r2;
+    row_pair_from_index(m, p, &r1, &r2);
+    while (win->scanned < pairs) {
+        if (deadline_tick(dl, n)) break;
+        RectMove cand;
+        rect_pair_best(m, n, cost, alloc, pair_diff, r1, r2, &cand);
+        if (verify) {
+            RectMove ref;
+            rect_best_for_pair_brute(m, n, cost, alloc, r1, r2, &ref);
+            if (rect_move_better(&cand, &ref) || rect_move_better(&ref, &cand)) {
+                fprintf(stderr, "VERIFY GAGAL pada pasangan (r%d,r%d): scan delta=%d c1=%d c2=%d T%d, brute delta=%d c1=%d c2=%d T%d\n",
+                        r1+1, r2+1, cand.delta, cand.c1+1, cand.c2+1, cand.type2 ? 2 : 1,
+                        ref.delta, ref.c1+1, ref.c2+1, ref.type2 ? 2 : 1);
+                abort();
             }
         }
+        if (rect_move_better(&cand, &best)) best = cand;
+        win->scanned++;
+        if (++p == pairs) p = 0;
+        if (++r2 == m) { r1 = r1 + 2 == m ? 0 : r1 + 1; r2 = r1 + 1; }
+        if (best.delta < 0 && win->scanned % win->block == 0) break;
+    }
+    win->start = p;
+    return best;
+}
 
-        if (VERBOSE) {
-            printf("   Setelah move -> at flc: %d, at slc: %d\n", alloc[i_flc][coorselisih], alloc[i_slc][coorselisih]);
-            print_supply_status(m, supply, total_alloc_baris);
-            print_alloc_matrix_int(m, n, alloc);
-            long long tot = total_biaya(m, n, cost, alloc);
-            printf("   Total cost sekarang = %lld\n", tot);
+/* Daftar kandidat PIVOT_LIST: kandidat terbaik per pasangan baris, cap pasangan terbaik, urut
+ * rect_move_better (terbaik di depan). Hanya berisi kandidat yang memperbaiki. */
+typedef struct {
+    RectMove *item;
+    int len, cap;
+} RectCandList;
+
+static void rect_list_insert(RectCandList *cl, const RectMove *mv) {
+    if (mv->delta >= 0) return;
+    if (cl->len == cl->cap && !rect_move_better(mv, &cl->item[cl->len - 1])) return;
+    int k = cl->len < cl->cap ? cl->len++ : cl->len - 1;
+    for (; k > 0 && rect_move_better(mv, &cl->item[k - 1]); k--) cl->item[k] = cl->item[k - 1];
+    cl->item[k] = *mv;
+}
+
+/* Satu scan penuh semua pasangan baris, simpan cap pasangan terbaik. Kembalikan jumlah pasangan yang dicek. */
+static long long rect_list_build(int m, int n, int cost[m][n], int alloc[m][n], const int *pair_diff,
+                                 RectCandList *cl, SsmDeadline *dl) {
+    long long scanned = 0;
+    cl->len = 0;
+    for (int r1 = 0; r1 < m; r1++)
+        for (int r2 = r1 + 1; r2 < m; r2++) {
+            if (deadline_tick(dl, n)) return scanned;
+            RectMove cand;
+            rect_pair_best(m, n, cost, alloc, pair_diff, r1, r2, &cand);
+            rect_list_insert(cl, &cand);
+            scanned++;
         }
+    return scanned;
+}
+
+/* Setelah move pada baris a dan b: kandidat yang pasangannya memuat a atau b dihitung ulang, yang tidak lagi
+ * memperbaiki dibuang, lalu daftar diurutkan ulang. Kembalikan jumlah pasangan yang dihitung ulang. */
+static int rect_list_revalidate(int m, int n, int cost[m][n], int alloc[m][n], const int *pair_diff,
+                                RectCandList *cl, int a, int b) {
+    int redo = 0, len = cl->len;
+    for (int k = 0; k < len; k++) {
+        RectMove *it = &cl->item[k];
+        int r1 = it->r1, r2 = it->r2;
+        if (r1 != a && r1 != b && r2 != a && r2 != b) continue;
+        rect_pair_best(m, n, cost, alloc, pair_diff, r1, r2, it);
+        redo++;
+    }
+    cl->len = 0;
+    for (int k = 0; k < len; k++) {
+        RectMove mv = cl->item[k];
+        if (mv.delta < 0) rect_list_insert(cl, &mv); // cl->len <= k: tidak menimpa entri yang belum dibaca
     }
+    return redo;
+}
 
-    if (VERBOSE) {
-        printf("\n=== SSM FEASIBILITY PHASE: END (iterasi = %d) ===\n", itertemp);
-        print_alloc_matrix_int(m, n, alloc);
+/* Cache kandidat terbaik per pasangan baris. Satu move hanya mengubah sel di baris r1 dan r2,
+ * jadi hanya rectangle yang memuat salah satu baris tersebut yang perlu dicek ulang. */
+typedef struct {
+    RectMove *pair_best; // m*(m-1)/2 entri, index row_pair_index()
+    const int *pair_diff; // NULL atau vektor selisih bersama (lihat rect_pair_best)
+} RectCache;
+
+/* Jika dl habis, pasangan yang belum dihitung diisi no_rect_move (cache hanya berisi kandidat valid) */
+static void rect_cache_build(int m, int n, int cost[m][n], int alloc[m][n], RectCache *rc, SsmDeadline *dl) {
+    bool stop = false;
+    for (int r1 = 0; r1 < m; r1++)
+        for (int r2 = r1 + 1; r2 < m; r2++) {
+            RectMove *slot = &rc->pair_best[row_pair_index(m, r1, r2)];
+            stop = stop || deadline_tick(dl, n);
+            if (stop) *slot = no_rect_move;
+            else rect_pair_best(m, n, cost, alloc, rc->pair_diff, r1, r2, slot);
+        }
+}
+
+static void rect_cache_refresh_row(int m, int n, int cost[m][n], int alloc[m][n], RectCache *rc, int r, int skip) {
+    for (int x = 0; x < m; x++) {
+        if (x == r || x == skip) continue;
+        int a = x < r ? x : r, b = x < r ? r : x;
+        rect_pair_best(m, n, cost, alloc, rc->pair_diff, a, b, &rc->pair_best[row_pair_index(m, a, b)]);
     }
 }
 
-int main(void)
-{
-    int sudah_optimal[36] = {0};  
-    int total_optimal = 0, total_belum = 0, total_diproses = 0;
+static RectMove rect_cache_best(int m, const RectCache *rc) {
+    RectMove best = no_rect_move;
+    size_t pairs = (size_t)m * (size_t)(m - 1) / 2;
+    for (size_t p = 0; p < pairs; p++)
+        if (rect_move_better(&rc->pair_best[p], &best)) best = rc->pair_best[p];
+    return best;
+}
 
-    for (int k = 1; k <= 35; k++) {
-        if (optimal_solution[k] == -1) continue;
-        char filename[20];
-        sprintf(filename, "testcase/n%02d.txt", k);
-        FILE *in = fopen(filename, "r");
+/* Pool thread untuk best-improvement paralel. Pasangan baris dibagi per r1 lewat counter atomik;
+ * tiap worker menyimpan kandidat terbaiknya sendiri, lalu digabung dengan rect_move_better.
+ * Karena urutan tersebut total (posisi rectangle memutus semua seri), hasilnya identik dengan serial. */
+typedef struct RectScanPool RectScanPool;
 
-        if (in == NULL) {
-            continue;
-        }
-        
-        printf("\n\n################################################################\n");
-        printf("### PROCESSING FILE: %s\n", filename);
-        printf("################################################################\n");
+typedef struct {
+    _Alignas(64) RectScanPool *pool;
+    RectMove best;
+} RectScanWorker;
 
-        int m, n; 
-        if (fscanf(in,"%d", &m) == EOF) { fclose(in); continue; }
-        fscanf(in,"%d", &n);
-        
-        int cost[m][n], alloc[m][n], supply[m], demand[n];
-        for (int i=0;i<m;i++)
-            for (int j=0;j<n;j++)
-                fscanf(in,"%d",&cost[i][j]);
-        for (int i=0;i<m;i++)
-            fscanf(in,"%d",&supply[i]);
-        for (int j=0;j<n;j++)
-            fscanf(in,"%d",&demand[j]);
-        fclose(in);
-
-        if (VERBOSE) {
-            printf("\n--- INPUT SUMMARY ---\n");
-            printf("Dimensions : rows (m) = %d, cols (n) = %d\n", m, n);
-            print_array_int("Supply", m, supply);
-            print_array_int("Demand", n, demand);
-            print_cost_matrix(m, n, cost, demand, supply);
-            printf("----------------------\n\n");
-        }
-
-        make_feasible_ssm(m,n,cost,supply,demand,alloc);
-        improve_with_rectangles(m,n,cost,alloc);
-
-        long long tot = total_biaya(m,n,cost,alloc);
-        printf("\n>>> Total Transportation Cost (final) : %lld\n", tot);
+struct RectScanPool {
+    int m, n, nthreads;
+    int *cost, *alloc;
+    const int *pair_diff;
+    atomic_int next_r1;
+    uint64_t deadline_ns;  // 0 = tanpa batas waktu, jam dibaca sekali per r1 (m-r1-1 pasangan)
+    long long budget;      // sisa budget kerja untuk satu pencarian, LLONG_MAX = tanpa batas
+    atomic_llong work;     // unit kerja (pasangan x n) yang sudah diambil worker pada pencarian berjalan
+    atomic_bool expired;
+    bool stop;
+    pthread_mutex_t init_lock;
+    pthread_barrier_t start, done;
+    pthread_t *tids;
+    RectScanWorker *workers;
+};
 
-        if (tot == (long long)optimal_solution[k]) {
-            printf(">>> Status: OPTIMAL (sesuai nilai yang diharapkan %d)\n", optimal_solution[k]);
-            sudah_optimal[k] = 1;
-            total_optimal++;
-        } else {
-            printf(">>> Status: BELUM OPTIMAL (seharusnya %d, diperoleh %lld)\n", optimal_solution[k], tot);
-            sudah_optimal[k] = 0;
-            total_belum++;
+static void rect_scan_pool_run(RectScanWorker *w) {
+    RectScanPool *p = w->pool;
+    int m = p->m, n = p->n;
+    int (*cost)[n] = (int (*)[n])p->cost;
+    int (*alloc)[n] = (int (*)[n])p->alloc;
+    w->best = no_rect_move;
+    for (int r1 = atomic_fetch_add(&p->next_r1, 1); r1 < m; r1 = atomic_fetch_add(&p->next_r1, 1)) {
+        if (atomic_load(&p->expired)) break;
+        if (p->deadline_ns != 0 && now_ns() >= p->deadline_ns) {
+            atomic_store(&p->expired, true);
+            break;
+        }
+        // Budget dicek per r1 seperti jam: r1 yang sudah diambil dikerjakan penuh, overshoot < nthreads x m x n
+        long long units = (long long)(m - r1 - 1) * n;
+        if (atomic_fetch_add(&p->work, units) >= p->budget) {
+            atomic_fetch_sub(&p->work, units);
+            atomic_store(&p->expired, true);
+            break;
+        }
+        for (int r2 = r1 + 1; r2 < m; r2++) {
+            RectMove cand;
+            rect_pair_best(m, n, cost, alloc, p->pair_diff, r1, r2, &cand);
+            if (rect_move_better(&cand, &w->best)) w->best = cand;
         }
-        total_diproses++;
-        printf("================================================================\n");
     }
+}
 
-    printf("\n====================== SUMMARY ======================\n");
-    printf(" Total file yang diproses : %d\n", total_diproses);
-    printf(" Total optimal         : %d\n", total_optimal);
-    printf(" Total belum optimal   : %d\n", total_belum);
-    if (total_diproses > 0) {
+static void *rect_scan_pool_thread(void *arg) {
+    RectScanWorker *w = arg;
+    RectScanPool *p = w->pool;
+    pthread_mutex_lock(&p->init_lock);
+    pthread_mutex_unlock(&p->init_lock);
+    while (true) {
+        pthread_barrier_wait(&p->start);
+        if (p->stop) break;
+        rect_scan_pool_run(w);
+        pthread_barrier_wait(&p->done);
+    }
+    return NULL;
+}
+
+/* Thread pemanggil ikut bekerja sebagai worker 0, jadi hanya nthreads-1 thread yang dibuat.
+ * Jika pembuatan thread gagal, pool tetap jalan dengan thread yang berhasil dibuat. */
+static bool rect_scan_pool_start(RectScanPool *p, int m, int n, int cost[m][n], int alloc[m][n], const int *pair_diff,
+                                 int nthreads, uint64_t deadline_ns) {
+    p->m = m; p->n = n;
+    p->cost = &cost[0][0]; p->alloc = &alloc[0][0];
+    p->pair_diff = pair_diff;
+    p->deadline_ns = deadline_ns;
+    atomic_init(&p->expired, false);
+    atomic_init(&p->work, 0);
+    p->budget = LLONG_MAX;
+    p->stop = false;
+    p->tids = malloc((size_t)nthreads * sizeof(pthread_t));
+    p->workers = aligned_alloc(64, (size_t)nthreads * sizeof(RectScanWorker));
+    if (p->tids == NULL || p->workers == NULL) {
+        free(p->tids); free(p->workers);
+        return false;
+    }
+    for (int t = 0; t < nthreads; t++) p->workers[t].pool = p;
+
+    // Worker menunggu di init_lock sampai barrier diinisialisasi dengan jumlah thread yang sebenarnya
+    pthread_mutex_init(&p->init_lock, NULL);
+    pthread_mutex_lock(&p->init_lock);
+    p->nthreads = 1;
+    for (int t = 1; t < nthreads; t++) {
+        if (pthread_create(&p->tids[t], NULL, rect_scan_pool_thread, &p->workers[t]) != 0) {
+            printf("Peringatan: hanya %d thread yang berhasil dibuat untuk pencarian rectangle.\n", t);
+            break;
+        }
+        p->nthreads++;
+    }
+    pthread_barrier_init(&p->start, NULL, (unsigned)p->nthreads);
+    pthread_barrier_init(&p->done, NULL, (unsigned)p->nthreads);
+    pthread_mutex_unlock(&p->init_lock);
+    return true;
+}
+
+/* budget: sisa unit kerja yang boleh dipakai pencarian ini (LLONG_MAX = tanpa batas); kerja yang benar-benar
+ * dipakai dibaca dari p->work setelahnya */
+static RectMove rect_scan_pool_search(RectScanPool *p, long long budget) {
+    atomic_store(&p->next_r1, 0);
+    atomic_store(&p->work, 0);
+    p->budget = budget;
+    pthread_barrier_wait(&p->start);
+    rect_scan_pool_run(&p->workers[0]);
+    pthread_barrier_wait(&p->done);
+
+    RectMove best = no_rect_move;
+    for (int t = 0; t < p->nthreads; t++)
+        if (rect_move_better(&p->workers[t].best, &best)) best = p->workers[t].best;
+    return best;
+}
+
+static void rect_scan_pool_stop(RectScanPool *p) {
+    p->stop = true;
+    pthread_barrier_wait(&p->start);
+    for (int t = 1; t < p->nthreads; t++) pthread_join(p->tids[t], NULL);
+    pthread_barrier_destroy(&p->start);
+    pthread_barrier_destroy(&p->done);
+    pthread_mutex_destroy(&p->init_lock);
+    free(p->tids);
+    free(p->workers);
+}
+
+/* Daftar sel teralokasi (alloc > 0) per baris dan per kolom. Solusi transportasi hanya punya
+ * sekitar m+n-1 sel positif, jadi pencarian donor cukup menelusuri daftar ini, bukan matriks penuh.
+ * Setiap perubahan alokasi harus lewat cells_add() agar daftar tetap sinkron. */
+typedef struct {
+    int r, c;
+    int rnext, rprev, cnext, cprev;
+} CellNode;
+
+typedef struct {
+    int *cell_at;             // m x n: index node sel (i,j), -1 jika alloc 0
+    int *row_head, *row_cnt;  // m
+    int *col_head, *col_cnt;  // n
+    CellNode *nodes;          // pool node (tumbuh dengan realloc, dipakai ulang antar instance)
+    int *order;               // scratch: sel terurut per baris untuk pencarian pasangan donor
+    int *row_start;           // scratch m+1
+    int cap, used, free_head, count;
+} CellLists;
+
+static void cells_reset(CellLists *cl, int m, int n) {
+    size_t mn = (size_t)m * (size_t)n;
+    for (size_t k = 0; k < mn; k++) cl->cell_at[k] = -1;
+    for (int i = 0; i < m; i++) { cl->row_head[i] = -1; cl->row_cnt[i] = 0; }
+    for (int j = 0; j < n; j++) { cl->col_head[j] = -1; cl->col_cnt[j] = 0; }
+    cl->used = 0;
+    cl->free_head = -1;
+    cl->count = 0;
+}
+
+static int cells_new_node(CellLists *cl) {
+    if (cl->free_head >= 0) {
+        int k = cl->free_head;
+        cl->free_head = cl->nodes[k].rnext;
+        return k;
+    }
+    if (cl->used == cl->cap) {
+        int cap = cl->cap > 0 ? 2 * cl->cap : 256;
+        CellNode *nodes = realloc(cl->nodes, (size_t)cap * sizeof(CellNode));
+        int *order = realloc(cl->order, (size_t)cap * sizeof(int));
+        if (nodes != NULL) cl->nodes = nodes;
+        if (order != NULL) cl->order = order;
+        if (nodes == NULL || order == NULL) {
+            fprintf(stderr, "Gagal menambah kapasitas daftar sel (%d node).\n", cap);
+            exit(1);
+        }
+        cl->cap = cap;
+    }
+    return cl->used++;
+}
+
+static void cells_insert(CellLists *cl, int n, int i, int j) {
+    int k = cells_new_node(cl);
+    CellNode *nd = &cl->nodes[k];
+    nd->r = i; nd->c = j;
+    nd->rprev = -1; nd->rnext = cl->row_head[i];
+    if (nd->rnext >= 0) cl->nodes[nd->rnext].rprev = k;
+    cl->row_head[i] = k;
+    nd->cprev = -1; nd->cnext = cl->col_head[j];
+    if (nd->cnext >= 0) cl->nodes[nd->cnext].cprev = k;
+    cl->col_head[j] = k;
+    cl->cell_at[(size_t)i * n + j] = k;
+    cl->row_cnt[i]++; cl->col_cnt[j]++; cl->count++;
+}
+
+static void cells_remove(CellLists *cl, int n, int i, int j) {
+    int k = cl->cell_at[(size_t)i * n + j];
+    CellNode *nd = &cl->nodes[k];
+    if (nd->rprev >= 0) cl->nodes[nd->rprev].rnext = nd->rnext; else cl->row_head[i] = nd->rnext;
+    if (nd->rnext >= 0) cl->nodes[nd->rnext].rprev = nd->rprev;
+    if (nd->cprev >= 0) cl->nodes[nd->cprev].cnext = nd->cnext; else cl->col_head[j] = nd->cnext;
+    if (nd->cnext >= 0) cl->nodes[nd->cnext].cprev = nd->cprev;
+    cl->cell_at[(size_t)i * n + j] = -1;
+    cl->row_cnt[i]--; cl->col_cnt[j]--; cl->count--;
+    nd->rnext = cl->free_head;
+    cl->free_head = k;
+}
+
+/* alloc[i][j] += delta, sambil menjaga daftar sel tetap sinkron */
+static void cells_add(CellLists *cl, int m, int n, int alloc[m][n], int i, int j, int delta) {
+    int before = alloc[i][j];
+    alloc[i][j] += delta;
+    if (before <= 0 && alloc[i][j] > 0) cells_insert(cl, n, i, j);
+    else if (before > 0 && alloc[i][j] <= 0) cells_remove(cl, n, i, j);
+}
+
+static void cells_build(CellLists *cl, int m, int n, int alloc[m][n]) {
+    cells_reset(cl, m, n);
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+            if (alloc[i][j] > 0) cells_insert(cl, n, i, j);
+}
+
+// Rectangle dengan sel donor (r1,ca) dan (r2,cb), r1 < r2, ca != cb
+static RectMove rect_from_donors(int m, int n, int cost[m][n], int r1, int ca, int r2, int cb) {
+    int delta = (cost[r1][cb] + cost[r2][ca]) - (cost[r1][ca] + cost[r2][cb]);
+    if (ca < cb) return (RectMove){ delta, r1, ca, r2, cb, false };
+    return (RectMove){ delta, r1, cb, r2, ca, true };
+}
+
+/* Best-improvement dengan enumerasi pasangan sel donor, O(B^2) dengan B = jumlah sel positif.
+ * Dua sel positif (r1,ca) dan (r2,cb) dengan r1 < r2 dan ca != cb adalah donor T1 (ca < cb)
+ * atau donor T2 (ca > cb) untuk tepat satu rectangle. */
+static RectMove search_rectangles_sparse(int m, int n, int cost[m][n], CellLists *cl, long long *evaluated,
+                                         SsmDeadline *dl) {
+    int B = 0;
+    for (int i = 0; i < m; i++) {
+        cl->row_start[i] = B;
+        for (int k = cl->row_head[i]; k >= 0; k = cl->nodes[k].rnext) cl->order[B++] = k;
+    }
+    cl->row_start[m] = B;
+
+    RectMove best = no_rect_move;
+    for (int r1 = 0; r1 < m; r1++) {
+        *evaluated += (long long)(cl->row_start[r1 + 1] - cl->row_start[r1]) * (B - cl->row_start[r1 + 1]);
+        for (int a = cl->row_start[r1]; a < cl->row_start[r1 + 1]; a++) {
+            if (deadline_tick(dl, B - cl->row_start[r1 + 1])) return best;
+            int ca = cl->nodes[cl->order[a]].c;
+            for (int b = cl->row_start[r1 + 1]; b < B; b++) {
+                const CellNode *nb = &cl->nodes[cl->order[b]];
+                int r2 = nb->r, cb = nb->c;
+                if (ca == cb) continue;
+                RectMove cand = rect_from_donors(m, n, cost, r1, ca, r2, cb);
+                if (cand.delta < 0 && rect_move_better(&cand, &best)) best = cand;
+            }
+        }
+    }
+    return best;
+}
+
+/* Terapkan satu move rectangle, kembalikan theta yang dipindahkan (0 jika tidak ada) */
+static int apply_rectangle_move(int m, int n, int cost[m][n], int alloc[m][n], CellLists *cl, const RectMove *mv, int iter) {
+    int r1 = mv->r1, c1 = mv->c1, r2 = mv->r2, c2 = mv->c2;
+    int theta;
+
+    if (LOG_STEPS) {
+        printf("\n--- Perbaikan iterasi %d ---\n", iter);
+        printf(" Koordinat rectangle: (r%d,c%d), (r%d,c%d)  |  tipe perbaikan: %s  |  delta=%d\n",
+               r1+1, c1+1, r2+1, c2+1, mv->type2 ? "Tipe 2" : "Tipe 1", mv->delta);
+        printf(" Nilai sebelum: (r%d,c%d)=%d, (r%d,c%d)=%d, (r%d,c%d)=%d, (r%d,c%d)=%d\n",
+               r1+1, c1+1, alloc[r1][c1], r1+1, c2+1, alloc[r1][c2], r2+1, c1+1, alloc[r2][c1], r2+1, c2+1, alloc[r2][c2]);
+    }
+
+    // Lakukan update alokasi berdasarkan tipe perbaikan yang ditemukan
+    if (!mv->type2) {
+        // Tipe 1: Kurangi dari (r1,c1) & (r2,c2)
+        theta = alloc[r1][c1] < alloc[r2][c2] ? alloc[r1][c1] : alloc[r2][c2];
+
+        if (LOG_STEPS) {
+            printf(" Tentukan theta (T1): min(alloc[r%d][c%d], alloc[r%d][c%d]) = min(%d, %d) = %d\n",
+                   r1+1, c1+1, r2+1, c2+1, alloc[r1][c1], alloc[r2][c2], theta);
+            printf(" Pergeseran (theta=%d):\n", theta);
+            printf("  (r%d,c%d) [penerima] = %d + %d = %d\n", r1+1, c2+1, alloc[r1][c2], theta, alloc[r1][c2] + theta);
+            printf("  (r%d,c%d) [penerima] = %d + %d = %d\n", r2+1, c1+1, alloc[r2][c1], theta, alloc[r2][c1] + theta);
+            printf("  (r%d,c%d) [donor]    = %d - %d = %d\n", r1+1, c1+1, alloc[r1][c1], theta, alloc[r1][c1] - theta);
+            printf("  (r%d,c%d) [donor]    = %d - %d = %d\n", r2+1, c2+1, alloc[r2][c2], theta, alloc[r2][c2] - theta);
+        }
+        if (theta <= 0) return 0;
+
+        cells_add(cl, m, n, alloc, r1, c2, theta);
+        cells_add(cl, m, n, alloc, r2, c1, theta);
+        cells_add(cl, m, n, alloc, r1, c1, -theta);
+        cells_add(cl, m, n, alloc, r2, c2, -theta);
+    } else {
+        // Tipe 2: Kurangi dari (r1,c2) & (r2,c1)
+        theta = alloc[r1][c2] < alloc[r2][c1] ? alloc[r1][c2] : alloc[r2][c1];
+
+         if (LOG_STEPS) {
+             printf(" Tentukan theta (T2): min(alloc[r%d][c%d], alloc[r%d][c%d]) = min(%d, %d) = %d\n",
+                   r1+1, c2+1, r2+1, c1+1, alloc[r1][c2], alloc[r2][c1], theta);
+            printf(" Pergeseran (theta=%d):\n", theta);
+            printf("  (r%d,c%d) [penerima] = %d + %d = %d\n", r1+1, c1+1, alloc[r1][c1], theta, alloc[r1][c1] + theta);
+            printf("  (r%d,c%d) [penerima] = %d + %d = %d\n", r2+1, c2+1, alloc[r2][c2], theta, alloc[r2][c2] + theta);
+            printf("  (r%d,c%d) [donor]    = %d - %d = %d\n", r1+1, c2+1, alloc[r1][c2], theta, alloc[r1][c2] - theta);
+            printf("  (r%d,c%d) [donor]    = %d - %d = %d\n", r2+1, c1+1, alloc[r2][c1], theta, alloc[r2][c1] - theta);
+        }
+        if (theta <= 0) return 0;
+
+        cells_add(cl, m, n, alloc, r1, c1, theta);
+        cells_add(cl, m, n, alloc, r2, c2, theta);
+        cells_add(cl, m, n, alloc, r1, c2, -theta);
+        cells_add(cl, m, n, alloc, r2, c1, -theta);
+    }
+
+    if (LOG_STEPS) {
+        printf(" Nilai setelah:  (r%d,c%d)=%d, (r%d,c%d)=%d, (r%d,c%d)=%d, (r%d,c%d)=%d\n",
+               r1+1, c1+1, alloc[r1][c1], r1+1, c2+1, alloc[r1][c2], r2+1, c1+1, alloc[r2][c1], r2+1, c2+1, alloc[r2][c2]);
+        long long tot = total_biaya(m, n, cost, alloc);
+        printf(" Total cost setelah pembaruan = %lld\n", tot);
+        print_alloc_matrix_int(m, n, alloc);
+    }
+    return theta;
+}
+
+/* Workspace solver: satu blok heap (ter-align 64 byte) berisi semua array row-major untuk satu instance.
+ * Blok hanya dialokasikan ulang jika instance berikutnya lebih besar, jadi bisa dipakai ulang antar file. */
+#define WS_ALIGN 64
+#define SEED_LINE_FIELDS 17 // int per line (baris/kolom) yang dibutuhkan seed Vogel
+#define DUAL_MAX_COMP 128    // batas komponen untuk sistem pergeseran potensial (K^3 Bellman-Ford)
+
+/* Pohon basis network simplex. Node 0..m-1 = baris, m..m+n2-1 = kolom (n2 = n + 1 jika ada kolom dummy
+ * untuk sisa supply). Tiap node non-root menyimpan arc ke parent-nya beserta flow-nya, kedalaman,
+ * potensial (u untuk baris, v untuk kolom), daftar anak, dan thread (urutan preorder) untuk pivot. */
+typedef struct {
+    int m, n, n2;
+    int *parent, *depth, *flow;
+    int *first_child, *next_sib, *prev_sib;
+    int *thread, *rev_thread;
+    long long *pi;
+    long long *arc_cost; // biaya arc node -> parent (dipindah bersama arc saat pivot)
+    int *stack;          // scratch DFS
+    int next_row;        // baris awal block pricing berikutnya
+    long long block;     // ukuran blok pricing
+} NsTree;
+
+/* Urutan baris per kolom berdasarkan cost (naik, tie: indeks baris naik) -- hanya bergantung pada cost,
+ * dibangun sekali per matriks cost. rank[i*n+j] = posisi baris i pada urutan kolom j. cursor[j] menunjuk
+ * posisi pertama yang mungkin masih eligible (bukan ER dan bukan satisfied) untuk pencarian slc. */
+typedef struct {
+    int *order;          // n x m, order[j*m+k] = baris ke-k termurah di kolom j
+    int *rank;           // m x n, row-major
+    int *cursor;         // n
+    uint64_t *keys;      // max(m, n), scratch sorting
+} CostOrder;
+
+typedef struct {
+    long long key;       // delta Russell c_ij - u_i - v_j (batas bawah, hanya bisa naik)
+    int cell;            // i*n + j
+} RussellEntry;
+
+/* Struktur yang hanya bergantung pada matriks cost (bukan supply/demand). Dibangun sekali oleh
+ * cost_shared_build lalu dibaca bersama (read-only) oleh workspace semua skenario pada cost yang sama. */
+typedef struct {
+    int m, n;
+    size_t bytes;
+    unsigned char *base;
+    int *order, *rank;    // CostOrder.order / rank (FEAS_SCAN_SORTED, seed Vogel/Russell)
+    int *cost_t;          // FEAS_SCAN_SIMD
+    int *row_order;       // seed Vogel/Russell
+    uint64_t *cell_keys;  // seed least-cost, sudah terurut
+    int *pair_diff;       // m(m-1)/2 x n, d[c] = cost[r1][c] - cost[r2][c]; NULL jika melebihi batas memori
+} SsmCostShared;
+
+typedef struct {
+    size_t cap;           // ukuran blok saat ini (byte)
+    unsigned char *base;
+    int m, n;
+    int *cost, *alloc;    // m x n, row-major (cost NULL jika input di-mmap langsung)
+    int *supply;          // m
+    int *demand;          // n
+    int *total_alloc_baris, *arr, *satisfy; // m, scratch fase feasibility
+    int *flc, *slc, *diff, *konflik;        // n, scratch fase feasibility (konflik berisi stempel iterasi)
+    int *kcols;           // n, daftar kolom konflik pada iterasi berjalan
+    CostOrder corder;     // urutan kolom berdasarkan cost untuk pencarian slc (FEAS_SCAN_SORTED)
+    SsmMetrics metrics;   // counter per fase untuk instance terakhir
+    int *warm_rows, *warm_dirty; // m, baris kotor untuk re-solve warm start
+    int *warm_cols;       // n, penanda kolom saat perubahan warm start divalidasi
+    long long *dual_u, *dual_v;  // m, n: potensial untuk lower bound dual
+    int *dual_queue, *dual_comp; // m+n, BFS atas sel positif dan komponen tiap baris/kolom
+    long long *dual_w, *dual_dist; // (K+1)^2 dan K+1, K = min(m, DUAL_MAX_COMP): sistem pergeseran komponen
+    SsmDeadline deadline; // batas waktu/kerja solve berjalan (lihat deadline_arm)
+    const SsmCostShared *shared; // non-NULL: struktur cost dipakai bersama, tidak dibangun/dialokasikan ulang
+    TraceSink *trace;     // NULL = trace mati
+    int *cost_t;          // n x m, salinan cost kolom-mayor (FEAS_SCAN_SIMD)
+    int *row_order;       // m x n, kolom per baris urut cost (seed Vogel/Russell)
+    uint64_t *cell_keys;  // m*n, kunci sort sel (seed least-cost)
+    RussellEntry *rheap;  // m*n (seed Russell)
+    int *seed_lines;      // SEED_LINE_FIELDS * (m+n), status baris/kolom untuk seed (bukan SSM)
+    RectMove *pair_best;  // m*(m-1)/2, hanya untuk RECT_SEARCH_INCREMENTAL
+    RectMove *pivot_list; // pivot_k, hanya untuk PIVOT_LIST
+    CellLists cells;      // daftar sel positif per baris/kolom
+    NsTree ns;            // m+n+1 node, hanya jika fase eksak aktif
+} SsmWorkspace;
+
+static void ws_carve(unsigned char *base, size_t *off, size_t bytes, void **out) {
+    size_t at = *off;
+    *off += (bytes + WS_ALIGN - 1) & ~(size_t)(WS_ALIGN - 1);
+    if (base != NULL) *out = base + at;
+}
+
+/* Hitung layout (base == NULL) atau pasang pointer ke dalam blok (base != NULL), kembalikan total byte */
+static size_t ssm_workspace_layout(SsmWorkspace *ws, unsigned char *base, int m, int n, const SsmOptions *opt, bool with_input) {
+    size_t off = 0, mn = (size_t)m * (size_t)n;
+    size_t pairs = (opt->rect_mode == RECT_SEARCH_INCREMENTAL && m >= 2) ? (size_t)m * (size_t)(m - 1) / 2 : 0;
+    size_t in_mn = with_input ? mn : 0, in_m = with_input ? (size_t)m : 0, in_n = with_input ? (size_t)n : 0;
+    ws_carve(base, &off, in_mn * sizeof(int), (void **)&ws->cost);
+    ws_carve(base, &off, mn * sizeof(int), (void **)&ws->alloc);
+    ws_carve(base, &off, in_m * sizeof(int), (void **)&ws->supply);
+    ws_carve(base, &off, in_n * sizeof(int), (void **)&ws->demand);
+    ws_carve(base, &off, (size_t)m * sizeof(int), (void **)&ws->total_alloc_baris);
+    ws_carve(base, &off, (size_t)m * sizeof(int), (void **)&ws->arr);
+    ws_carve(base, &off, (size_t)m * sizeof(int), (void **)&ws->satisfy);
+    ws_carve(base, &off, (size_t)n * sizeof(int), (void **)&ws->flc);
+    ws_carve(base, &off, (size_t)n * sizeof(int), (void **)&ws->slc);
+    ws_carve(base, &off, (size_t)n * sizeof(int), (void **)&ws->diff);
+    ws_carve(base, &off, (size_t)n * sizeof(int), (void **)&ws->konflik);
+    ws_carve(base, &off, (size_t)n * sizeof(int), (void **)&ws->kcols);
+    ws_carve(base, &off, (size_t)m * sizeof(int), (void **)&ws->warm_rows);
+    ws_carve(base, &off, (size_t)m * sizeof(int), (void **)&ws->warm_dirty);
+    ws_carve(base, &off, (size_t)n * sizeof(int), (void **)&ws->warm_cols);
+    ws_carve(base, &off, (size_t)m * sizeof(long long), (void **)&ws->dual_u);
+    ws_carve(base, &off, (size_t)n * sizeof(long long), (void **)&ws->dual_v);
+    ws_carve(base, &off, ((size_t)m + n) * sizeof(int), (void **)&ws->dual_queue);
+    ws_carve(base, &off, ((size_t)m + n) * sizeof(int), (void **)&ws->dual_comp);
+    size_t kmax = (size_t)(m < DUAL_MAX_COMP ? m : DUAL_MAX_COMP) + 1;
+    ws_carve(base, &off, kmax * kmax * sizeof(long long), (void **)&ws->dual_w);
+    ws_carve(base, &off, kmax * sizeof(long long), (void **)&ws->dual_dist);
+    bool line_seed = opt->seed == SEED_VOGEL || opt->seed == SEED_RUSSELL;
+    bool sorted = opt->feas_scan == FEAS_SCAN_SORTED || line_seed;
+    size_t mxn = (size_t)(m > n ? m : n), own_mn = ws->shared != NULL ? 0 : mn;
+    ws_carve(base, &off, sorted ? own_mn * sizeof(int) : 0, (void **)&ws->corder.order);
+    ws_carve(base, &off, sorted ? own_mn * sizeof(int) : 0, (void **)&ws->corder.rank);
+    ws_carve(base, &off, sorted ? (size_t)n * sizeof(int) : 0, (void **)&ws->corder.cursor);
+    ws_carve(base, &off, sorted ? mxn * sizeof(uint64_t) : 0, (void **)&ws->corder.keys);
+    ws_carve(base, &off, opt->feas_scan == FEAS_SCAN_SIMD ? own_mn * sizeof(int) : 0, (void **)&ws->cost_t);
+    ws_carve(base, &off, line_seed ? own_mn * sizeof(int) : 0, (void **)&ws->row_order);
+    ws_carve(base, &off, opt->seed == SEED_LEAST_COST ? own_mn * sizeof(uint64_t) : 0, (void **)&ws->cell_keys);
+    ws_carve(base, &off, opt->seed == SEED_RUSSELL ? mn * sizeof(RussellEntry) : 0, (void **)&ws->rheap);
+    ws_carve(base, &off, opt->seed != SEED_SSM ? SEED_LINE_FIELDS * ((size_t)m + n) * sizeof(int) : 0,
+             (void **)&ws->seed_lines);
+    ws_carve(base, &off, pairs * sizeof(RectMove), (void **)&ws->pair_best);
+    ws_carve(base, &off, (size_t)rect_pivot_list_cap(opt) * sizeof(RectMove), (void **)&ws->pivot_list);
+    ws_carve(base, &off, mn * sizeof(int), (void **)&ws->cells.cell_at);
+    ws_carve(base, &off, (size_t)m * sizeof(int), (void **)&ws->cells.row_head);
+    ws_carve(base, &off, (size_t)m * sizeof(int), (void **)&ws->cells.row_cnt);
+    ws_carve(base, &off, (size_t)n * sizeof(int), (void **)&ws->cells.col_head);
+    ws_carve(base, &off, (size_t)n * sizeof(int), (void **)&ws->cells.col_cnt);
+    ws_carve(base, &off, ((size_t)m + 1) * sizeof(int), (void **)&ws->cells.row_start);
+    size_t nodes = opt->exact ? (size_t)m + (size_t)n + 1 : 0;
+    int **ns_arrays[] = { &ws->ns.parent, &ws->ns.depth, &ws->ns.flow, &ws->ns.first_child, &ws->ns.next_sib,
+                          &ws->ns.prev_sib, &ws->ns.thread, &ws->ns.rev_thread, &ws->ns.stack };
+    for (size_t k = 0; k < sizeof ns_arrays / sizeof ns_arrays[0]; k++)
+        ws_carve(base, &off, nodes * sizeof(int), (void **)ns_arrays[k]);
+    ws_carve(base, &off, nodes * sizeof(long long), (void **)&ws->ns.pi);
+    ws_carve(base, &off, nodes * sizeof(long long), (void **)&ws->ns.arc_cost);
+    if (base != NULL && nodes == 0) ws->ns.parent = NULL;
+    if (base != NULL && pairs == 0) ws->pair_best = NULL;
+    if (base != NULL && !with_input) ws->cost = ws->supply = ws->demand = NULL;
+    if (base != NULL && ws->shared != NULL) {
+        const SsmCostShared *sh = ws->shared;
+        ws->corder.order = sh->order;
+        ws->corder.rank = sh->rank;
+        ws->cost_t = sh->cost_t;
+        ws->row_order = sh->row_order;
+        ws->cell_keys = sh->cell_keys;
+    }
+    return off;
+}
+
+/* Siapkan workspace untuk instance m x n. with_input = false jika cost/supply/demand dibaca
+ * langsung dari file yang di-mmap. Kembalikan false jika memori tidak cukup. */
+static bool ssm_workspace_prepare(SsmWorkspace *ws, int m, int n, const SsmOptions *opt, bool with_input) {
+    size_t need = ssm_workspace_layout(ws, NULL, m, n, opt, with_input);
+    if (need > ws->cap) {
+        free(ws->base);
+        ws->base = aligned_alloc(WS_ALIGN, need);
+        ws->cap = ws->base != NULL ? need : 0;
+        if (ws->base == NULL) return false;
+    }
+    ssm_workspace_layout(ws, ws->base, m, n, opt, with_input);
+    ws->m = m; ws->n = n;
+    return true;
+}
+
+static void ssm_workspace_free(SsmWorkspace *ws) {
+    free(ws->cells.nodes);
+    free(ws->cells.order);
+    free(ws->base);
+    memset(ws, 0, sizeof *ws);
+}
+
+static void warm_mark_row(SsmWorkspace *ws, int *nrows, int r) {
+    if (ws->warm_dirty[r]) return;
+    ws->warm_dirty[r] = 1;
+    ws->warm_rows[(*nrows)++] = r;
+}
+
+// Baris dengan sisa supply dan cost termurah di kolom j (tie: indeks terkecil), -1 jika tidak ada
+static int warm_cheapest_slack_row(int m, int n, int cost[m][n], const int *supply, const int *total, int j, int skip) {
+    int best = -1;
+    for (int r = 0; r < m; r++)
+        if (r != skip && total[r] < supply[r] && (best < 0 || cost[r][j] < cost[best][j])) best = r;
+    return best;
+}
+
+// Sel positif termahal pada baris i (row = true) atau kolom j, kembalikan indeks lawannya
+static int warm_most_expensive(int m, int n, int cost[m][n], const CellLists *cl, bool row, int idx) {
+    int best = -1;
+    if (row) {
+        for (int k = cl->row_head[idx]; k >= 0; k = cl->nodes[k].rnext) {
+            int c = cl->nodes[k].c;
+            if (best < 0 || cost[idx][c] > cost[idx][best] || (cost[idx][c] == cost[idx][best] && c < best)) best = c;
+        }
+    } else {
+        for (int k = cl->col_head[idx]; k >= 0; k = cl->nodes[k].cnext) {
+            int r = cl->nodes[k].r;
+            if (best < 0 || cost[r][idx] > cost[best][idx] || (cost[r][idx] == cost[best][idx] && r < best)) best = r;
+        }
+    }
+    return best;
+}
+
+/* Pindahkan kelebihan baris i (total[i] > supply[i]) dari sel termahalnya ke baris ber-sisa termurah di kolom yang
+ * sama sampai baris i tidak lagi over-supplied. Baris penerima ditandai kotor jika nrows != NULL.
+ * Kembalikan false jika tidak ada lagi baris dengan sisa supply. */
+static bool warm_shed_row_excess(int m, int n, int cost[m][n], const int *supply, int alloc[m][n], int *total, int i,
+                            SsmWorkspace *ws, int *nrows) {
+    CellLists *cl = &ws->cells;
+    while (total[i] > supply[i]) {
+        int j = warm_most_expensive(m, n, cost, cl, true, i);
+        int r = warm_cheapest_slack_row(m, n, cost, supply, total, j, i);
+        if (r < 0) return false;
+        int x = total[i] - supply[i];
+        if (x > alloc[i][j]) x = alloc[i][j];
+        if (x > supply[r] - total[r]) x = supply[r] - total[r];
+        cells_add(cl, m, n, alloc, i, j, -x);
+        cells_add(cl, m, n, alloc, r, j, x);
+        total[i] -= x; total[r] += x;
+        if (nrows != NULL) warm_mark_row(ws, nrows, r);
+    }
+    return true;
+}
+
+static long long cells_total_cost(int m, int n, int cost[m][n], int alloc[m][n], const CellLists *cl) {
+    long long tot = 0;
+    for (int i = 0; i < m; i++)
+        for (int k = cl->row_head[i]; k >= 0; k = cl->nodes[k].rnext)
+            tot += (long long)cost[i][cl->nodes[k].c] * alloc[i][cl->nodes[k].c];
+    return tot;
+}
+
+/* Lower bound dual untuk min sum c*x, sum_j x_ij <= s_i, sum_i x_ij = d_j. Setiap (u, v) dengan u_i <= 0 dan
+ * u_i + v_j <= c_ij memberi bound sum d_j v_j + sum s_i u_i (weak duality).
+ *  1. Potensial MODI dari sel positif: u_i + v_j = c_ij disebar lewat BFS per komponen, lalu digeser agar
+ *     max u = 0 di tiap komponen. Baris tanpa sel masuk komponen 0 dengan u = 0. Baris dengan supply 0 tidak
+ *     ikut bound (s_i u_i = 0 untuk u_i sekecil apa pun), jadi dilewati di semua langkah.
+ *  2. Pergeseran per komponen (u + delta_K, v - delta_K) tidak mengubah sel positif. Syarat dual antar
+ *     komponen, u <= 0, dan u = 0 untuk baris yang masih punya sisa supply adalah sistem difference constraint
+ *     delta_K - delta_L <= w. Sistem ini diselesaikan dengan Bellman-Ford dari komponen 0 (jarak terpendek =
+ *     delta terbesar, dan bound naik dengan delta karena supply komponen >= demand-nya). Jika alokasi
+ *     optimal, sistem ini feasible dan bound sama dengan cost. Jika ada cycle negatif atau komponen lebih dari
+ *     DUAL_MAX_COMP, pergeseran langkah 1 dipakai apa adanya.
+ *  3. Dual dibuat feasible dengan v_j = min_i (c_ij - u_i), lalu dikencangkan dengan
+ *     u_i = min(0, min_j (c_ij - v_j)) dan v_j dihitung ulang; setiap langkah hanya bisa menaikkan bound.
+ * O(mn + B + K^3) dengan K = jumlah komponen. */
+static long long dual_lower_bound(int m, int n, int cost[m][n], const int *supply, const int *demand, int alloc[m][n],
+                                  SsmWorkspace *ws) {
+    const CellLists *cl = &ws->cells;
+    long long *u = ws->dual_u, *v = ws->dual_v, *w = ws->dual_w, *dist = ws->dual_dist;
+    int *queue = ws->dual_queue, *comp = ws->dual_comp; // comp[0..m) baris, comp[m..m+n) kolom
+    int k = 1;
+    for (int x = 0; x < m + n; x++) comp[x] = -1;
+
+    // Komponen 1..k-1 dari sel positif; komponen 0 = baris tanpa sel (u = 0), kolom tanpa sel tetap -1
+    for (int root = 0; root < m; root++) {
+        if (comp[root] >= 0) continue;
+        if (cl->row_head[root] < 0) { // supply 0: u bebas (-tak hingga), baris diabaikan dengan comp -1
+            u[root] = 0;
+            if (supply[root] > 0) comp[root] = 0;
+            continue;
+        }
+        int head = 0, tail = 0;
+        long long umax = 0;
+        u[root] = 0;
+        comp[root] = k;
+        queue[tail++] = root;
+        while (head < tail) {
+            int x = queue[head++];
+            if (x < m) {
+                umax = u[x] > umax ? u[x] : umax;
+                for (int c = cl->row_head[x]; c >= 0; c = cl->nodes[c].rnext) {
+                    int j = cl->nodes[c].c;
+                    if (comp[m + j] < 0) { comp[m + j] = k; v[j] = cost[x][j] - u[x]; queue[tail++] = m + j; }
+                }
+            } else {
+                for (int c = cl->col_head[x - m]; c >= 0; c = cl->nodes[c].cnext) {
+                    int r = cl->nodes[c].r;
+                    if (comp[r] < 0) { comp[r] = k; u[r] = cost[r][x - m] - v[x - m]; queue[tail++] = r; }
+                }
+            }
+        }
+        for (int t = 0; t < tail; t++) {
+            if (queue[t] < m) u[queue[t]] -= umax;
+            else v[queue[t] - m] += umax;
+        }
+        k++;
+    }
+
+    if (k - 1 <= DUAL_MAX_COMP) {
+        // w[L*k + K] = bobot edge L -> K: delta_K <= delta_L + w
+        for (size_t e = 0; e < (size_t)k * k; e++) w[e] = LLONG_MAX;
+        for (int i = 0; i < m; i++) {
+            int K = comp[i];
+            if (K < 0) continue;
+            for (int j = 0; j < n; j++) {
+                int L = comp[m + j];
+                if (L <= 0 || L == K) continue;
+                long long r = cost[i][j] - u[i] - v[j];
+                if (r < w[(size_t)L * k + K]) w[(size_t)L * k + K] = r;
+            }
+        }
+        for (int i = 0; i < m; i++) {
+            int K = comp[i];
+            if (K <= 0) continue;
+            long long total = 0;
+            for (int c = cl->row_head[i]; c >= 0; c = cl->nodes[c].rnext) total += alloc[i][cl->nodes[c].c];
+            if (-u[i] < w[K]) w[K] = -u[i];                                   // u_i + delta_K <= 0
+            if (total < supply[i] && u[i] < w[(size_t)K * k]) w[(size_t)K * k] = u[i]; // bersisa: u_i + delta_K = 0
+        }
+        for (int K = 0; K < k; K++) dist[K] = K == 0 ? 0 : LLONG_MAX;
+        bool changed = true;
+        for (int pass = 0; pass <= k && changed; pass++) {
+            changed = false;
+            for (int L = 0; L < k; L++) {
+                if (dist[L] == LLONG_MAX) continue;
+                for (int K = 0; K < k; K++) {
+                    long long e = w[(size_t)L * k + K];
+                    if (e != LLONG_MAX && dist[L] + e < dist[K]) { dist[K] = dist[L] + e; changed = true; }
+                }
+            }
+        }
+        if (!changed && dist[0] == 0)
+            for (int i = 0; i < m; i++)
+                if (comp[i] >= 0) u[i] += dist[comp[i]];
+    }
+
+    for (int round = 0; round < 2; round++) {
+        for (int j = 0; j < n; j++) v[j] = LLONG_MAX;
+        for (int i = 0; i < m; i++) {
+            if (supply[i] == 0) continue;
+            for (int j = 0; j < n; j++)
+                if (cost[i][j] - u[i] < v[j]) v[j] = cost[i][j] - u[i];
+        }
+        if (round == 1) break;
+        for (int i = 0; i < m; i++) {
+            if (supply[i] == 0) continue;
+            long long best = 0;
+            for (int j = 0; j < n; j++)
+                if (cost[i][j] - v[j] < best) best = cost[i][j] - v[j];
+            u[i] = best;
+        }
+    }
+
+    long long lb = 0;
+    for (int j = 0; j < n; j++) lb += (long long)demand[j] * v[j];
+    for (int i = 0; i < m; i++) if (supply[i] > 0) lb += (long long)supply[i] * u[i];
+    return lb;
+}
+
+/* Perbarui bound terbaik dengan alokasi saat ini (butuh ws->cells sinkron). Kembalikan true jika gap sudah
+ * tertutup (cur_cost == bound, alokasi terbukti optimal). Tanpa bound jika total supply < total demand. */
+static bool update_lower_bound(int m, int n, int cost[m][n], const int *supply, const int *demand, int alloc[m][n],
+                               long long cur_cost, SsmWorkspace *ws) {
+    SsmMetrics *mt = &ws->metrics;
+    long long sum_s = 0, sum_d = 0;
+    for (int i = 0; i < m; i++) sum_s += supply[i];
+    for (int j = 0; j < n; j++) sum_d += demand[j];
+    if (sum_s < sum_d) return false;
+    long long lb = dual_lower_bound(m, n, cost, supply, demand, alloc, ws);
+    deadline_tick(&ws->deadline, 3LL * m * n);
+    if (!mt->has_bound || lb > mt->lower_bound) mt->lower_bound = lb;
+    mt->has_bound = true;
+    if (ws->deadline.incumbent) {
+        _Atomic long long *b = &ws->deadline.incumbent->bound;
+        long long cur = atomic_load(b);
+        while (lb > cur && !atomic_compare_exchange_weak(b, &cur, lb)) {}
+    }
+    return cur_cost <= mt->lower_bound;
+}
+
+static void rect_stop_early(SsmMetrics *mt, int iter) {
+    if (LOG_STEPS) printf("\nBatas waktu/kerja habis setelah %d iterasi rectangle. Optimisasi dihentikan.\n", iter);
+    if (!mt->early_stop) mt->stop_phase = PHASE_RECT; // fase seed yang terpotong tetap dilaporkan
+    mt->early_stop = true;
+}
+
+/* Kembalikan jumlah move rectangle yang diterapkan. metrics.rect_evaluated menghitung kandidat yang diperiksa:
+ * rectangle (exhaustive), langkah kolom per pasangan baris (scan/incremental/verify), pasangan sel donor (sparse). */
+static int improve_with_rectangles(int m, int n, int cost[m][n], int supply[m], int demand[n], int alloc[m][n],
+                                   const SsmOptions *opt, SsmWorkspace *ws) {
+    int iter = 0;
+    SsmMetrics *mt = &ws->metrics;
+    long long pairs = (long long)m * (m - 1) / 2;
+    const int *pair_diff = ws->shared != NULL ? ws->shared->pair_diff : NULL;
+    RectCache rc = { ws->pair_best, pair_diff };
+    RectScanPool pool;
+    bool use_pool = false;
+    RectPivotRule pivot = rect_pivot_rule(opt);
+    RectScanWindow win = { 0, pairs > 0 ? pairs : 1, 0 };
+    if (pivot == PIVOT_FIRST) win.block = 1;
+    if (pivot == PIVOT_BLOCK) win.block = opt->pivot_block > 0 ? opt->pivot_block : m;
+    RectCandList clist = { ws->pivot_list, 0, rect_pivot_list_cap(opt) };
+
+    if (LOG_STEPS) {
+        printf("\n=== RECTANGLE IMPROVEMENT PHASE: START ===\n");
+        print_alloc_matrix_int(m, n, alloc);
+    }
+
+    SsmDeadline *dl = &ws->deadline;
+    cells_build(&ws->cells, m, n, alloc);
+
+    // Bound dual dicek di awal, lalu setiap kali pencarian sudah memeriksa max(32mn, 1/8 kandidat fase ini)
+    // kandidat sejak cek terakhir. Satu cek ~4 pass O(mn), jadi jumlah cek tumbuh logaritmik dan kerja
+    // tambahan setelah gap tertutup paling banyak ~1/8, bukan scan konfirmasi penuh.
+    long long cur_cost = cells_total_cost(m, n, cost, alloc, &ws->cells);
+    long long lb_start = mt->rect_evaluated, lb_mark = lb_start, lb_min = 32LL * m * n;
+    dl->cur_cost = cur_cost;
+    bool closed = update_lower_bound(m, n, cost, supply, demand, alloc, cur_cost, ws);
+
+    if (rc.pair_best != NULL && !closed) {
+        rect_cache_build(m, n, cost, alloc, &rc, dl);
+        mt->rect_evaluated += pairs * n;
+    }
+    if (opt->rect_mode == RECT_SEARCH_SCAN && pivot == PIVOT_BEST && opt->threads > 1 && m >= 2 && !closed) {
+        use_pool = rect_scan_pool_start(&pool, m, n, cost, alloc, pair_diff, opt->threads, dl->deadline_ns);
+    }
+
+    // Loop utama yang akan terus berjalan selama perbaikan masih ditemukan. Jika batas waktu/kerja habis di
+    // tengah pencarian, kandidat terbaik sejauh ini masih diterapkan (setiap move menjaga feasibility dan
+    // menurunkan cost), lalu loop berhenti.
+    while (!closed) {
+        RectMove best;
+        if (rc.pair_best != NULL) {
+            best = rect_cache_best(m, &rc);
+            if (LOG_RECT_STEPS) {
+                printf("\n[Pencarian Iterasi %d] Kandidat terbaik dari cache pasangan baris. Best delta ditemukan: %d\n",
+                       iter + 1, best.delta);
+            }
+        } else if (opt->rect_mode == RECT_SEARCH_EXHAUSTIVE) {
+            best = search_rectangles_exhaustive(m, n, cost, alloc, iter, dl);
+            mt->rect_evaluated += pairs * ((long long)n * (n - 1) / 2);
+        } else if (opt->rect_mode == RECT_SEARCH_SPARSE) {
+            best = search_rectangles_sparse(m, n, cost, &ws->cells, &mt->rect_evaluated, dl);
+            if (LOG_RECT_STEPS) {
+                printf("\n[Pencarian Iterasi %d] Enumerasi pasangan dari %d sel donor. Best delta ditemukan: %d\n",
+                       iter + 1, ws->cells.count, best.delta);
+            }
+        } else if (pivot == PIVOT_LIST) {
+            // Daftar kosong (semua kandidat sudah terpakai/tidak valid): isi ulang dengan satu scan penuh
+            if (clist.len == 0) mt->rect_evaluated += rect_list_build(m, n, cost, alloc, pair_diff, &clist, dl) * n;
+            best = clist.len > 0 ? clist.item[0] : no_rect_move;
+            if (LOG_RECT_STEPS) {
+                printf("\n[Pencarian Iterasi %d] %d kandidat di daftar. Best delta ditemukan: %d\n",
+                       iter + 1, clist.len, best.delta);
+            }
+        } else {
+            if (use_pool) {
+                best = rect_scan_pool_search(&pool, dl->budget > 0 ? dl->budget - dl->work : LLONG_MAX);
+                long long done = atomic_load(&pool.work);
+                deadline_tick(dl, done);
+                if (atomic_load(&pool.expired)) deadline_check(dl);
+                mt->rect_evaluated += done;
+            } else {
+                best = search_rectangles_scan(m, n, cost, alloc, pair_diff, opt->rect_mode == RECT_SEARCH_VERIFY,
+                                              &win, dl);
+                mt->rect_evaluated += win.scanned * n;
+            }
+            if (LOG_RECT_STEPS) {
+                printf("\n[Pencarian Iterasi %d] Scan %lld pasangan baris. Best delta ditemukan: %d\n",
+                       iter + 1, pairs, best.delta);
+            }
+        }
+
+        // Jika setelah dicek semua kemungkinan tidak ada delta negatif, optimasi selesai.
+        if (best.delta >= 0) {
+            if (dl->expired) { rect_stop_early(mt, iter); break; }
+            if (LOG_STEPS) printf("\nTidak ditemukan rectangle yang memperbaiki (best_delta=%d). Optimisasi rectangle selesai.\n", best.delta);
+            break; // Keluar dari loop while(true)
+        }
+
+        iter++;
+        int theta = apply_rectangle_move(m, n, cost, alloc, &ws->cells, &best, iter);
+        mt->rect_moves++;
+        mt->theta_moved += theta;
+        cur_cost += (long long)best.delta * theta;
+        dl->cur_cost = cur_cost;
+        TRACE(ws->trace, TR_RECT_MOVE, iter, best.r1, best.c1, best.r2, best.c2, best.delta, theta, best.type2);
+        if (theta <= 0) continue;
+
+        // Hanya baris r1 dan r2 yang berubah: cek ulang semua pasangan yang memuat salah satunya
+        if (rc.pair_best != NULL) {
+            rect_cache_refresh_row(m, n, cost, alloc, &rc, best.r1, -1);
+            rect_cache_refresh_row(m, n, cost, alloc, &rc, best.r2, best.r1);
+            mt->rect_evaluated += (long long)(2 * m - 3) * n;
+            deadline_tick(dl, (long long)(2 * m - 3) * n);
+        }
+        if (pivot == PIVOT_LIST) {
+            long long redo = rect_list_revalidate(m, n, cost, alloc, pair_diff, &clist, best.r1, best.r2);
+            mt->rect_evaluated += redo * n;
+            deadline_tick(dl, redo * n);
+        }
+        if (dl->expired) { rect_stop_early(mt, iter); break; }
+        long long since = mt->rect_evaluated - lb_mark, phase = mt->rect_evaluated - lb_start;
+        if (since >= lb_min && since >= phase / 8) {
+            lb_mark = mt->rect_evaluated;
+            closed = update_lower_bound(m, n, cost, supply, demand, alloc, cur_cost, ws);
+        }
+    }
+    if (closed) {
+        mt->gap_closed = true;
+        if (LOG_STEPS) printf("\nCost %lld sama dengan lower bound dual: alokasi terbukti optimal. Optimisasi rectangle selesai.\n", cur_cost);
+    }
+
+    if (use_pool) rect_scan_pool_stop(&pool);
+
+    if (LOG_STEPS) {
+        printf("\n[RECTANGLE SUMMARY] Total perbaikan rectangle yang diterapkan: %d iterasi.\n", iter);
+        printf("=== RECTANGLE IMPROVEMENT PHASE: END ===\n");
+    }
+    return iter;
+}
+
+/* Kernel argmin untuk scan kolom fase feasibility (data kolom-mayor, kontigu).
+ * argmin        : indeks pertama dengan nilai minimum (len >= 1), sama dengan scan "cost[rmin] > cost[i]".
+ * argmin_masked : hanya baris dengan arr[i] == 0 && sat[i] == 0, perbandingan "< best" dengan best awal
+ *                 INT_MAX (baris bernilai INT_MAX tidak pernah terpilih); -1 jika tidak ada.
+ * Varian SIMD menyimpan minimum + indeks pertama per lane, lalu reduksi memilih nilai terkecil dengan indeks
+ * terkecil, sehingga hasilnya identik dengan versi skalar. ISA dipilih saat runtime. */
+typedef struct {
+    const char *name;
+    int (*argmin)(const int *v, int len);
+    int (*argmin_masked)(const int *v, const int *arr, const int *sat, int len);
+} ArgminKernels;
+
+static int argmin_scalar(const int *v, int len) {
+    int best = 0;
+    for (int i = 1; i < len; i++) if (v[best] > v[i]) best = i;
+    return best;
+}
+
+static int argmin_masked_scalar(const int *v, const int *arr, const int *sat, int len) {
+    int best = -1, bv = INT_MAX;
+    for (int i = 0; i < len; i++)
+        if (!arr[i] && !sat[i] && v[i] < bv) { bv = v[i]; best = i; }
+    return best;
+}
+
+#ifdef SSM_X86
+/* Reduksi lane: nilai terkecil, tie -> indeks terkecil. Lane yang tidak pernah terisi berindeks -1. */
+static void argmin_reduce_lanes(const int *val, const int *idx, int lanes, int *bv, int *bi) {
+    for (int l = 0; l < lanes; l++) {
+        if (idx[l] < 0) continue;
+        if (*bi < 0 || val[l] < *bv || (val[l] == *bv && idx[l] < *bi)) { *bv = val[l]; *bi = idx[l]; }
+    }
+}
+
+__attribute__((target("sse4.1")))
+static int argmin_scan_sse41(const int *v, const int *arr, const int *sat, int len) {
+    const __m128i big = _mm_set1_epi32(INT_MAX), zero = _mm_setzero_si128(), step = _mm_set1_epi32(4);
+    __m128i best = big, besti = _mm_set1_epi32(-1), idx = _mm_setr_epi32(0, 1, 2, 3);
+    int i = 0;
+    for (; i + 4 <= len; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(v + i));
+        if (arr != NULL) {
+            __m128i bad = _mm_or_si128(_mm_loadu_si128((const __m128i *)(arr + i)),
+                                       _mm_loadu_si128((const __m128i *)(sat + i)));
+            x = _mm_blendv_epi8(big, x, _mm_cmpeq_epi32(bad, zero));
+        }
+        __m128i lt = _mm_cmpgt_epi32(best, x);
+        best = _mm_blendv_epi8(best, x, lt);
+        besti = _mm_blendv_epi8(besti, idx, lt);
+        idx = _mm_add_epi32(idx, step);
+    }
+    int val[4], ix[4], bv = INT_MAX, bi = -1;
+    _mm_storeu_si128((__m128i *)val, best);
+    _mm_storeu_si128((__m128i *)ix, besti);
+    argmin_reduce_lanes(val, ix, 4, &bv, &bi);
+    for (; i < len; i++)
+        if ((arr == NULL || (!arr[i] && !sat[i])) && v[i] < bv) { bv = v[i]; bi = i; }
+    return bi;
+}
+
+__attribute__((target("avx2")))
+static int argmin_scan_avx2(const int *v, const int *arr, const int *sat, int len) {
+    const __m256i big = _mm256_set1_epi32(INT_MAX), zero = _mm256_setzero_si256(), step = _mm256_set1_epi32(8);
+    __m256i best = big, besti = _mm256_set1_epi32(-1), idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    int i = 0;
+    for (; i + 8 <= len; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(v + i));
+        if (arr != NULL) {
+            __m256i bad = _mm256_or_si256(_mm256_loadu_si256((const __m256i *)(arr + i)),
+                                          _mm256_loadu_si256((const __m256i *)(sat + i)));
+            x = _mm256_blendv_epi8(big, x, _mm256_cmpeq_epi32(bad, zero));
+        }
+        __m256i lt = _mm256_cmpgt_epi32(best, x);
+        best = _mm256_blendv_epi8(best, x, lt);
+        besti = _mm256_blendv_epi8(besti, idx, lt);
+        idx = _mm256_add_epi32(idx, step);
+    }
+    int val[8], ix[8], bv = INT_MAX, bi = -1;
+    _mm256_storeu_si256((__m256i *)val, best);
+    _mm256_storeu_si256((__m256i *)ix, besti);
+    argmin_reduce_lanes(val, ix, 8, &bv, &bi);
+    for (; i < len; i++)
+        if ((arr == NULL || (!arr[i] && !sat[i])) && v[i] < bv) { bv = v[i]; bi = i; }
+    return bi;
+}
+
+// Tanpa mask, semua nilai INT_MAX berarti indeks pertama (0) adalah argmin
+static int argmin_sse41(const int *v, int len) { int i = argmin_scan_sse41(v, NULL, NULL, len); return i < 0 ? 0 : i; }
+static int argmin_masked_sse41(const int *v, const int *arr, const int *sat, int len) { return argmin_scan_sse41(v, arr, sat, len); }
+static int argmin_avx2(const int *v, int len) { int i = argmin_scan_avx2(v, NULL, NULL, len); return i < 0 ? 0 : i; }
+static int argmin_masked_avx2(const int *v, const int *arr, const int *sat, int len) { return argmin_scan_avx2(v, arr, sat, len); }
+#endif
+
+static const ArgminKernels argmin_kernels_scalar = { "scalar", argmin_scalar, argmin_masked_scalar };
+#ifdef SSM_X86
+static const ArgminKernels argmin_kernels_sse41 = { "sse4.1", argmin_sse41, argmin_masked_sse41 };
+static const ArgminKernels argmin_kernels_avx2 = { "avx2", argmin_avx2, argmin_masked_avx2 };
+#endif
+
+// Pilih kernel terbaik yang didukung CPU saat ini
+static const ArgminKernels *argmin_kernels_detect(void) {
+#ifdef SSM_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return &argmin_kernels_avx2;
+    if (__builtin_cpu_supports("sse4.1")) return &argmin_kernels_sse41;
+#endif
+    return &argmin_kernels_scalar;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/* Bangun urutan baris per kolom (sekali per matriks cost, O(mn log m)). Kunci sort = (cost, baris) dalam
+ * satu uint64 sehingga urutannya sama persis dengan scan "cost terkecil, indeks pertama". */
+static void cost_order_build(int m, int n, int cost[m][n], CostOrder *co) {
+    for (int j = 0; j < n; j++) {
+        for (int i = 0; i < m; i++)
+            co->keys[i] = ((uint64_t)((uint32_t)cost[i][j] ^ 0x80000000u) << 32) | (uint32_t)i;
+        qsort(co->keys, (size_t)m, sizeof(uint64_t), cmp_u64);
+        int *ord = co->order + (size_t)j * m;
+        for (int k = 0; k < m; k++) {
+            ord[k] = (int)(co->keys[k] & 0xffffffffu);
+            co->rank[(size_t)ord[k] * n + j] = k;
+        }
+        co->cursor[j] = 0;
+    }
+}
+
+/* Baris i kembali eligible: tarik mundur cursor kolom yang sudah melewatinya */
+static void cost_order_readmit(int n, CostOrder *co, int i) {
+    const int *rk = co->rank + (size_t)i * n;
+    for (int j = 0; j < n; j++)
+        if (rk[j] < co->cursor[j]) co->cursor[j] = rk[j];
+}
+
+/* slc kolom j: baris eligible pertama pada urutan cost. Cursor hanya maju melewati baris yang tidak eligible;
+ * baris yang eligible lagi ditangani cost_order_readmit. */
+static int cost_order_first_eligible(int m, CostOrder *co, int j, const int *arr, const int *satisfy) {
+    const int *ord = co->order + (size_t)j * m;
+    int k = co->cursor[j];
+    while (k < m && (arr[ord[k]] || satisfy[ord[k]])) k++;
+    co->cursor[j] = k;
+    return k < m ? ord[k] : -1;
+}
+
+/* Prioritas acak tie-break (tie_seed != 0): hash splitmix64 dari (seed, a, b), jadi hasilnya deterministik */
+static uint64_t tie_priority(uint64_t seed, uint64_t a, uint64_t b) {
+    uint64_t z = seed ^ (a * 0x9E3779B97F4A7C15ULL) ^ (b * 0xD1B54A32D192ED03ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Baris `first` (cost terkecil yang eligible di kolom j) diganti baris eligible lain dengan cost sama dan
+ * prioritas acak terbesar. Hanya menelusuri run cost yang sama setelah cursor; cursor tidak berubah.
+ * arr == NULL: semua baris eligible (inisialisasi). */
+static int cost_order_random_tie(int m, int n, int cost[m][n], const CostOrder *co, int j, int first,
+                                 const int *arr, const int *satisfy, uint64_t seed, int iter) {
+    if (first < 0) return first;
+    const int *ord = co->order + (size_t)j * m;
+    int best = first;
+    uint64_t bp = tie_priority(seed, (uint64_t)iter << 32 | (uint32_t)j, (uint64_t)first);
+    for (int k = co->rank[(size_t)first * n + j] + 1; k < m && cost[ord[k]][j] == cost[first][j]; k++) {
+        int i = ord[k];
+        if (arr != NULL && (arr[i] || satisfy[i])) continue;
+        uint64_t p = tie_priority(seed, (uint64_t)iter << 32 | (uint32_t)j, (uint64_t)i);
+        if (p > bp) { bp = p; best = i; }
+    }
+    return best;
+}
+
+/* Salinan cost kolom-mayor (out[j*m+i] = cost[i][j]), per blok agar ramah cache */
+static void cost_transpose(int m, int n, int cost[m][n], int *out) {
+    const int B = 32;
+    for (int i0 = 0; i0 < m; i0 += B)
+        for (int j0 = 0; j0 < n; j0 += B)
+            for (int i = i0; i < m && i < i0 + B; i++)
+                for (int j = j0; j < n && j < j0 + B; j++)
+                    out[(size_t)j * m + i] = cost[i][j];
+}
+
+/* Perbarui status ER/S/NS baris i setelah total alokasinya berubah (co == NULL: tanpa cursor) */
+static void feas_update_row(int i, int n, const int *supply, const int *total, int *arr, int *satisfy,
+                            int *jumlah_ER, CostOrder *co) {
+    bool was_eligible = !arr[i] && !satisfy[i];
+    *jumlah_ER -= arr[i];
+    arr[i] = total[i] > supply[i];
+    satisfy[i] = total[i] == supply[i];
+    *jumlah_ER += arr[i];
+    if (co != NULL && !was_eligible && !arr[i] && !satisfy[i]) cost_order_readmit(n, co, i);
+}
+
+static void make_feasible_ssm(int m, int n, int cost[m][n], int supply[m], int demand[n], int alloc[m][n],
+                              const SsmOptions *opt, SsmWorkspace *ws) {
+    CellLists *cl = &ws->cells;
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+            alloc[i][j] = 0;
+    cells_reset(cl, m, n);
+    CostOrder *co = NULL;
+    const ArgminKernels *kern = argmin_kernels_detect();
+    if (opt->feas_scan == FEAS_SCAN_SORTED) {
+        co = &ws->corder;
+        if (ws->shared == NULL) cost_order_build(m, n, cost, co);
+        else for (int j = 0; j < n; j++) co->cursor[j] = 0;
+    } else if (ws->shared == NULL) {
+        cost_transpose(m, n, cost, ws->cost_t);
+    }
+
+    // Inisialisasi awal: isi demand ke baris biaya terendah per kolom (elemen pertama urutan kolom)
+    for (int j = 0; j < n; j++) {
+        int rmin = co != NULL ? co->order[(size_t)j * m] : kern->argmin(ws->cost_t + (size_t)j * m, m);
+        if (co != NULL && opt->tie_seed != 0)
+            rmin = cost_order_random_tie(m, n, cost, co, j, rmin, NULL, NULL, opt->tie_seed, 0);
+        cells_add(cl, m, n, alloc, rmin, j, demand[j]);
+        if (LOG_STEPS) printf("[init] kolom c%02d -> pilih baris r%02d (cost=%d) : alokasikan %d\n",
+                           j+1, rmin+1, cost[rmin][j], demand[j]);
+    }
+
+    int *total_alloc_baris = ws->total_alloc_baris;
+    int *arr = ws->arr, *satisfy = ws->satisfy;
+    int *flc = ws->flc, *slc = ws->slc, *diff = ws->diff, *konflik = ws->konflik, *kcols = ws->kcols;
+    int itertemp = 0, jumlah_ER = 0, coorselisih;
+    const int MAX_FEAS_ITERS = 2000;
+
+    // Total dan status baris dihitung sekali dari daftar sel, selanjutnya diperbarui per move (hanya flc & slc)
+    for (int i = 0; i < m; i++) {
+        total_alloc_baris[i] = 0;
+        for (int k = cl->row_head[i]; k >= 0; k = cl->nodes[k].rnext)
+            total_alloc_baris[i] += alloc[i][cl->nodes[k].c];
+        arr[i] = total_alloc_baris[i] > supply[i];
+        satisfy[i] = total_alloc_baris[i] == supply[i];
+        jumlah_ER += arr[i];
+    }
+    for (int j = 0; j < n; j++) konflik[j] = 0;
+
+    while (1) {
+
+        if (LOG_STEPS) {
+            printf("\n=== SSM FEASIBILITY ITER %d ===\n", itertemp);
+            printf("Keterangan: ER = over-supplied row, S = satisfied, NS = not-satisfied\n");
+            for (int i = 0; i < m; i++) {
+                for (int j = 0; j < n; j++) printf("%4d[%3d] ", cost[i][j], alloc[i][j]);
+                printf(" | S=%6d TA=%6d", supply[i], total_alloc_baris[i]);
+                if (arr[i]) printf("  <-- ER");
+                else if (satisfy[i]) printf("  <-- S");
+                else printf("  <-- NS");
+                printf("\n");
+            }
+            printf("---------------------------------------------------------------------\n");
+            print_supply_status(m, supply, total_alloc_baris);
+        }
+
+        if (jumlah_ER == 0) break;
+        // Batas waktu/kerja habis sebelum feasible: kelebihan baris ER dipindah langsung ke baris ber-sisa
+        // termurah per kolom (greedy least-cost), sehingga hasilnya tetap alokasi feasible
+        if (deadline_tick(&ws->deadline, m + n)) {
+            if (LOG_STEPS) printf("Batas waktu/kerja habis pada iterasi feasibility %d. Sisa ER diperbaiki secara greedy.\n", itertemp);
+            ws->metrics.early_stop = true;
+            ws->metrics.stop_phase = PHASE_SEED;
+            for (int i = 0; i < m; i++)
+                if (arr[i]) warm_shed_row_excess(m, n, cost, supply, alloc, total_alloc_baris, i, ws, NULL);
+            break;
+        }
+        itertemp++;
+        if (itertemp >= MAX_FEAS_ITERS) {
+            printf("Peringatan: Iterasi Feasibility mencapai batas maksimum (%d)!\n", MAX_FEAS_ITERS);
+            break;
+        }
+
+        // Tentukan kolom konflik (kolom yang memiliki alokasi pada row ER) dan flc (first conflicting row)
+        // per kolom, hanya dengan menelusuri daftar sel positif milik row ER (urut row naik => row pertama).
+        // konflik[j] == itertemp menandai kolom konflik iterasi ini, jadi tidak perlu reset O(n).
+        // FLC_COSTLIEST: flc diganti row ER berikutnya jika cost-nya di kolom itu lebih besar.
+        int nk = 0;
+        for (int i = 0; i < m; i++) {
+            if (arr[i] != 1) continue;
+            for (int k = cl->row_head[i]; k >= 0; k = cl->nodes[k].rnext) {
+                int j = cl->nodes[k].c;
+                if (konflik[j] != itertemp) { konflik[j] = itertemp; flc[j] = i; kcols[nk++] = j; }
+                else if (opt->flc_rule == FLC_COSTLIEST && cost[i][j] > cost[flc[j]][j]) flc[j] = i;
+            }
+        }
+
+        // slc (second candidate row): row dengan cost terendah yang bukan ER dan bukan SATISFY, dari urutan kolom;
+        // diff = selisih biaya slc - flc
+        for (int t = 0; t < nk; t++) {
+            int j = kcols[t];
+            slc[j] = co != NULL ? cost_order_first_eligible(m, co, j, arr, satisfy)
+                                : kern->argmin_masked(ws->cost_t + (size_t)j * m, arr, satisfy, m);
+            if (co != NULL && opt->tie_seed != 0)
+                slc[j] = cost_order_random_tie(m, n, cost, co, j, slc[j], arr, satisfy, opt->tie_seed, itertemp);
+            diff[j] = slc[j] != -1 ? cost[slc[j]][j] - cost[flc[j]][j] : INT_MAX / 2;
+        }
+
+        if (LOG_STEPS) {
+            printf("Summary Kolom Konflik (hanya menampilkan kolom konflik):\n");
+            printf(" col | flc(row,cost) | slc(row,cost) | diff | alokasi_di_flc\n");
+            printf("-----+---------------+----------------+------+--------------\n");
+            for (int j = 0; j < n; j++) {
+                if (konflik[j] == itertemp) {
+                    printf(" c%02d | r%02d,%4d     | ", j+1, flc[j]+1, cost[flc[j]][j]);
+                    if (slc[j] == -1) printf("   -,-        | ");
+                    else printf(" r%02d,%4d     | ", slc[j]+1, cost[slc[j]][j]);
+                    if (diff[j] >= INT_MAX / 4) printf("  -   | ");
+                    else printf("%4d | ", diff[j]);
+                    printf("%12d\n", (flc[j] == -1) ? 0 : alloc[flc[j]][j]);
+                }
+            }
+        }
+
+        // Pilih kolom dengan diff minimal (tie-breaker: alokasi lebih besar pada flc, lalu indeks kolom terkecil;
+        // dengan tie_seed tie diputus prioritas acak)
+        coorselisih = -1;
+        for (int t = 0; t < nk; t++) {
+            int j = kcols[t];
+            if (slc[j] == -1) continue;
+            if (coorselisih == -1 || diff[j] < diff[coorselisih]) { coorselisih = j; continue; }
+            if (diff[j] > diff[coorselisih]) continue;
+            if (opt->tie_seed != 0) {
+                uint64_t salt = (uint64_t)itertemp << 32 | 0xffffffffu;
+                if (tie_priority(opt->tie_seed, salt, (uint64_t)j) > tie_priority(opt->tie_seed, salt, (uint64_t)coorselisih))
+                    coorselisih = j;
+                continue;
+            }
+            int a = alloc[flc[j]][j], b = alloc[flc[coorselisih]][coorselisih];
+            if (a > b || (a == b && j < coorselisih)) coorselisih = j;
+        }
+
+        if (coorselisih == -1) {
+            if (LOG_STEPS) printf("Tidak ditemukan kolom konflik yang dapat dipindahkan pada iterasi ini. Keluar dari loop feasibility.\n");
+            break;
+        }
+
+        int i_flc = flc[coorselisih];
+        int i_slc = slc[coorselisih];
+        int slc_sebelum = alloc[i_slc][coorselisih];
+
+        if (LOG_STEPS) {
+            printf("-> Kolom terpilih untuk dipindah: c%02d | flc = r%02d | slc = r%02d | diff = %d\n",
+                   coorselisih+1, i_flc+1, i_slc+1, diff[coorselisih]);
+            printf("   Alokasi di flc sebelum pemindahan: %d\n", alloc[i_flc][coorselisih]);
+        }
+
+        if (supply[i_flc] == supply[i_slc]) {
+            int move = total_alloc_baris[i_flc] - supply[i_flc];
+            if (move < 0) move = alloc[i_flc][coorselisih];
+            if (move > alloc[i_flc][coorselisih]) move = alloc[i_flc][coorselisih];
+            if (LOG_STEPS) printf("   Case: supply sama. move = %d\n", move);
+            cells_add(cl, m, n, alloc, i_flc, coorselisih, -move);
+            cells_add(cl, m, n, alloc, i_slc, coorselisih, move);
+        }
+        else if (jumlah_ER >= 2) {
+            if (supply[i_flc] > supply[i_slc]) {
+                int move = total_alloc_baris[i_flc] - supply[i_flc];
+                if (move > alloc[i_flc][coorselisih]) move = alloc[i_flc][coorselisih];
+                if (LOG_STEPS) printf("   Case: jumlah_ER>=2 and supply[flc] > supply[slc]. move = %d\n", move);
+                cells_add(cl, m, n, alloc, i_flc, coorselisih, -move);
+                cells_add(cl, m, n, alloc, i_slc, coorselisih, move);
+            } else {
+                int alloc_sisa = supply[i_slc] - total_alloc_baris[i_slc];
+                if (LOG_STEPS) printf("   Case: jumlah_ER>=2 and supply[flc] <= supply[slc]. alloc_sisa = %d\n", alloc_sisa);
+                if (alloc_sisa >= alloc[i_flc][coorselisih]) {
+                    int all = alloc[i_flc][coorselisih];
+                    cells_add(cl, m, n, alloc, i_slc, coorselisih, all);
+                    cells_add(cl, m, n, alloc, i_flc, coorselisih, -all);
+                } else {
+                    cells_add(cl, m, n, alloc, i_slc, coorselisih, alloc_sisa);
+                    cells_add(cl, m, n, alloc, i_flc, coorselisih, -alloc_sisa);
+                }
+            }
+        } else {
+            if (supply[i_flc] < supply[i_slc]) {
+                int move = total_alloc_baris[i_flc] - supply[i_flc];
+                if (move > alloc[i_flc][coorselisih]) move = alloc[i_flc][coorselisih];
+                if (LOG_STEPS) printf("   Case: jumlah_ER<2 and supply[flc] < supply[slc]. move = %d\n", move);
+                cells_add(cl, m, n, alloc, i_flc, coorselisih, -move);
+                cells_add(cl, m, n, alloc, i_slc, coorselisih, move);
+            } else {
+                int alloc_sisa = supply[i_slc] - total_alloc_baris[i_slc];
+                if (LOG_STEPS) printf("   Case: jumlah_ER<2 and supply[flc] >= supply[slc]. alloc_sisa = %d\n", alloc_sisa);
+                if (alloc_sisa >= alloc[i_flc][coorselisih]) {
+                    int all = alloc[i_flc][coorselisih];
+                    cells_add(cl, m, n, alloc, i_slc, coorselisih, all);
+                    cells_add(cl, m, n, alloc, i_flc, coorselisih, -all);
+                } else {
+                    cells_add(cl, m, n, alloc, i_slc, coorselisih, alloc_sisa);
+                    cells_add(cl, m, n, alloc, i_flc, coorselisih, -alloc_sisa);
+                }
+            }
+        }
+
+        if (LOG_STEPS) {
+            printf("   Setelah move -> at flc: %d, at slc: %d\n", alloc[i_flc][coorselisih], alloc[i_slc][coorselisih]);
+            print_supply_status(m, supply, total_alloc_baris);
+            print_alloc_matrix_int(m, n, alloc);
+            long long tot = total_biaya(m, n, cost, alloc);
+            printf("   Total cost sekarang = %lld\n", tot);
+        }
+
+        int moved = alloc[i_slc][coorselisih] - slc_sebelum;
+        TRACE(ws->trace, TR_FEAS_MOVE, itertemp, coorselisih, i_flc, i_slc, moved, jumlah_ER);
+        total_alloc_baris[i_flc] -= moved;
+        total_alloc_baris[i_slc] += moved;
+        feas_update_row(i_flc, n, supply, total_alloc_baris, arr, satisfy, &jumlah_ER, co);
+        feas_update_row(i_slc, n, supply, total_alloc_baris, arr, satisfy, &jumlah_ER, co);
+    }
+
+    ws->metrics.feas_iters = itertemp;
+    if (LOG_STEPS) {
+        printf("\n=== SSM FEASIBILITY PHASE: END (iterasi = %d) ===\n", itertemp);
+        print_alloc_matrix_int(m, n, alloc);
+    }
+}
+
+/* ==================== Strategi solusi awal (seed) ==================== */
+
+/* Semua strategi mengisi alloc dari nol dengan alokasi x = min(sisa supply, sisa demand) dan berhenti saat
+ * tidak ada baris atau kolom aktif lagi, jadi hasilnya feasible jika total supply >= total demand. */
+
+typedef void (*SeedFn)(int m, int n, int cost[m][n], int supply[m], int demand[n], int alloc[m][n],
+                       const SsmOptions *opt, SsmWorkspace *ws);
+
+/* Urutan kolom per baris berdasarkan cost (naik, tie: indeks kolom naik) */
+static void row_order_build(int m, int n, int cost[m][n], int *row_order, uint64_t *keys) {
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++)
+            keys[j] = ((uint64_t)((uint32_t)cost[i][j] ^ 0x80000000u) << 32) | (uint32_t)j;
+        qsort(keys, (size_t)n, sizeof(uint64_t), cmp_u64);
+        for (int j = 0; j < n; j++) row_order[(size_t)i * n + j] = (int)(keys[j] & 0xffffffffu);
+    }
+}
+
+/* Semua sel diurutkan berdasarkan (cost, i, j); kunci = (cost, indeks sel) dalam satu uint64 */
+static void cell_keys_build(int m, int n, int cost[m][n], uint64_t *keys) {
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+            keys[(size_t)i * n + j] = ((uint64_t)((uint32_t)cost[i][j] ^ 0x80000000u) << 32) | (uint32_t)((size_t)i * n + j);
+    qsort(keys, (size_t)m * n, sizeof(uint64_t), cmp_u64);
+}
+
+// Alokasikan sebanyak mungkin di sel (i,j); rem[0..m) = sisa supply, rem[m..m+n) = sisa demand
+static int seed_allocate(int n, int alloc[][n], int *rem, int m, int i, int j) {
+    int x = rem[i] < rem[m + j] ? rem[i] : rem[m + j];
+    alloc[i][j] += x;
+    rem[i] -= x;
+    rem[m + j] -= x;
+    return x;
+}
+
+static void seed_begin(int m, int n, int supply[m], int demand[n], int alloc[m][n], int *rem, int *active,
+                       int *rows_left, int *cols_left) {
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++) alloc[i][j] = 0;
+    *rows_left = *cols_left = 0;
+    for (int i = 0; i < m; i++) { rem[i] = supply[i]; active[i] = supply[i] > 0; *rows_left += active[i]; }
+    for (int j = 0; j < n; j++) { rem[m + j] = demand[j]; active[m + j] = demand[j] > 0; *cols_left += active[m + j]; }
+}
+
+/* Batas waktu/kerja habis di tengah seed: sisa demand tiap kolom diambil dari baris ber-sisa termurah (greedy
+ * least-cost per kolom, O(m) per alokasi), jadi hasilnya tetap alokasi feasible seperti jalur greedy pada
+ * feasibility SSM */
+static void seed_finish_early(int m, int n, int cost[m][n], int alloc[m][n], int *rem, SsmWorkspace *ws) {
+    for (int j = 0; j < n; j++) {
+        while (rem[m + j] > 0) {
+            int best = -1;
+            for (int r = 0; r < m; r++)
+                if (rem[r] > 0 && (best < 0 || cost[r][j] < cost[best][j])) best = r;
+            if (best < 0) break; // total supply < total demand: sisa demand tidak bisa dilayani
+            seed_allocate(n, alloc, rem, m, best, j);
+        }
+    }
+    ws->metrics.early_stop = true;
+    ws->metrics.stop_phase = PHASE_SEED;
+    if (LOG_STEPS) printf("Batas waktu/kerja habis saat membangun seed. Sisa demand diambil dari baris termurah per kolom.\n");
+}
+
+/* Matrix least-cost: semua sel diurutkan sekali berdasarkan (cost, i, j), lalu diisi berurutan */
+static void seed_least_cost(int m, int n, int cost[m][n], int supply[m], int demand[n], int alloc[m][n],
+                            const SsmOptions *opt, SsmWorkspace *ws) {
+    (void)opt;
+    int *rem = ws->seed_lines, *active = rem + (m + n);
+    int rows_left, cols_left;
+    seed_begin(m, n, supply, demand, alloc, rem, active, &rows_left, &cols_left);
+
+    size_t mn = (size_t)m * n;
+    uint64_t *keys = ws->cell_keys;
+    if (ws->shared == NULL) cell_keys_build(m, n, cost, keys);
+    if (deadline_tick(&ws->deadline, (long long)mn)) { seed_finish_early(m, n, cost, alloc, rem, ws); return; }
+
+    for (size_t k = 0; k < mn && rows_left > 0 && cols_left > 0; k++) {
+        if (deadline_tick(&ws->deadline, 1)) { seed_finish_early(m, n, cost, alloc, rem, ws); return; }
+        int cell = (int)(keys[k] & 0xffffffffu), i = cell / n, j = cell % n;
+        if (!active[i] || !active[m + j]) continue;
+        seed_allocate(n, alloc, rem, m, i, j);
+        if (rem[i] == 0) { active[i] = 0; rows_left--; }
+        if (rem[m + j] == 0) { active[m + j] = 0; cols_left--; }
+    }
+}
+
+/* Vogel: tiap baris/kolom (line L, baris 0..m-1, kolom m..m+n-1) menyimpan dua posisi p1 < p2 pada urutan
+ * cost-nya yang menunjuk dua lawan aktif termurah; penalti = selisih keduanya (atau cost p1 jika tinggal satu).
+ * Line ada di max-heap berindeks (penalti besar, tie: cost minimum kecil, lalu indeks line kecil). Setiap line
+ * "mengawasi" dua target p1/p2 lewat daftar berantai, jadi saat satu line habis hanya line yang menunjuknya
+ * yang dihitung ulang. */
+typedef struct {
+    int m, n;
+    int (*cost)[];
+    const int *row_order, *col_order;
+    int *rem, *active, *p1, *p2, *hpos, *heap, *whead, *wnext, *wprev, *wtarget; // wnext/wprev/wtarget: 2 node per line
+    long long *pen, *kmin;
+    int hsize;
+} VogelState;
+
+static int vogel_target(const VogelState *v, int L, int pos) {
+    return L < v->m ? v->m + v->row_order[(size_t)L * v->n + pos] : v->col_order[(size_t)(L - v->m) * v->m + pos];
+}
+
+static long long vogel_cost(const VogelState *v, int L, int target) {
+    int (*cost)[v->n] = (int (*)[v->n])v->cost;
+    return L < v->m ? cost[L][target - v->m] : cost[target][L - v->m];
+}
+
+static bool vogel_better(const VogelState *v, int a, int b) {
+    if (v->pen[a] != v->pen[b]) return v->pen[a] > v->pen[b];
+    if (v->kmin[a] != v->kmin[b]) return v->kmin[a] < v->kmin[b];
+    return a < b;
+}
+
+static void vogel_heap_set(VogelState *v, int k, int L) { v->heap[k] = L; v->hpos[L] = k; }
+
+static void vogel_sift(VogelState *v, int k) {
+    int L = v->heap[k];
+    while (k > 0 && vogel_better(v, L, v->heap[(k - 1) / 2])) { vogel_heap_set(v, k, v->heap[(k - 1) / 2]); k = (k - 1) / 2; }
+    for (;;) {
+        int c = 2 * k + 1;
+        if (c >= v->hsize) break;
+        if (c + 1 < v->hsize && vogel_better(v, v->heap[c + 1], v->heap[c])) c++;
+        if (!vogel_better(v, v->heap[c], L)) break;
+        vogel_heap_set(v, k, v->heap[c]);
+        k = c;
+    }
+    vogel_heap_set(v, k, L);
+}
+
+static void vogel_heap_remove(VogelState *v, int L) {
+    int k = v->hpos[L];
+    if (k < 0) return;
+    v->hpos[L] = -1;
+    int last = v->heap[--v->hsize];
+    if (k == v->hsize) return;
+    vogel_heap_set(v, k, last);
+    vogel_sift(v, k);
+}
+
+static void vogel_watch(VogelState *v, int node, int target) {
+    if (v->wtarget[node] == target) return;
+    if (v->wtarget[node] >= 0) {
+        if (v->wprev[node] >= 0) v->wnext[v->wprev[node]] = v->wnext[node];
+        else v->whead[v->wtarget[node]] = v->wnext[node];
+        if (v->wnext[node] >= 0) v->wprev[v->wnext[node]] = v->wprev[node];
+    }
+    v->wtarget[node] = target;
+    if (target >= 0) {
+        v->wprev[node] = -1;
+        v->wnext[node] = v->whead[target];
+        if (v->whead[target] >= 0) v->wprev[v->whead[target]] = node;
+        v->whead[target] = node;
+    }
+}
+
+// Majukan p1/p2 melewati lawan yang sudah habis, hitung ulang penalti, dan perbarui posisi di heap
+static void vogel_refresh(VogelState *v, int L) {
+    int len = L < v->m ? v->n : v->m;
+    while (v->p1[L] < len && !v->active[vogel_target(v, L, v->p1[L])]) v->p1[L]++;
+    if (v->p2[L] <= v->p1[L]) v->p2[L] = v->p1[L] + 1;
+    while (v->p2[L] < len && !v->active[vogel_target(v, L, v->p2[L])]) v->p2[L]++;
+    int t1 = v->p1[L] < len ? vogel_target(v, L, v->p1[L]) : -1;
+    int t2 = v->p2[L] < len ? vogel_target(v, L, v->p2[L]) : -1;
+    vogel_watch(v, 2 * L, t1);
+    vogel_watch(v, 2 * L + 1, t2);
+    if (t1 < 0) { vogel_heap_remove(v, L); return; }
+    v->kmin[L] = vogel_cost(v, L, t1);
+    v->pen[L] = t2 >= 0 ? vogel_cost(v, L, t2) - v->kmin[L] : v->kmin[L];
+    if (v->hpos[L] < 0) { v->hpos[L] = v->hsize; v->heap[v->hsize++] = L; }
+    vogel_sift(v, v->hpos[L]);
+}
+
+static void vogel_retire(VogelState *v, int L) {
+    v->active[L] = 0;
+    vogel_heap_remove(v, L);
+    vogel_watch(v, 2 * L, -1);
+    vogel_watch(v, 2 * L + 1, -1);
+    while (v->whead[L] >= 0) vogel_refresh(v, v->whead[L] / 2); // refresh memindahkan node dari daftar L
+}
+
+static void seed_vogel(int m, int n, int cost[m][n], int supply[m], int demand[n], int alloc[m][n],
+                       const SsmOptions *opt, SsmWorkspace *ws) {
+    (void)opt;
+    int lines = m + n, *f = ws->seed_lines;
+    // pen/kmin (long long) di depan agar tetap ter-align 8 byte; wnext/wprev/wtarget berisi 2 node per line
+    VogelState v = { .m = m, .n = n, .cost = (int (*)[])cost, .row_order = ws->row_order, .col_order = ws->corder.order,
+                     .pen = (long long *)f, .kmin = (long long *)(f + 2 * lines),
+                     .rem = f + 4 * lines, .active = f + 5 * lines, .p1 = f + 6 * lines, .p2 = f + 7 * lines,
+                     .hpos = f + 8 * lines, .heap = f + 9 * lines, .whead = f + 10 * lines, .wnext = f + 11 * lines,
+                     .wprev = f + 13 * lines, .wtarget = f + 15 * lines, .hsize = 0 };
+    int rows_left, cols_left;
+    seed_begin(m, n, supply, demand, alloc, v.rem, v.active, &rows_left, &cols_left);
+    if (ws->shared == NULL) {
+        row_order_build(m, n, cost, ws->row_order, ws->corder.keys);
+        cost_order_build(m, n, cost, &ws->corder);
+    }
+    for (int L = 0; L < lines; L++) {
+        v.p1[L] = v.p2[L] = 0;
+        v.hpos[L] = -1;
+        v.whead[L] = -1;
+        v.wtarget[2 * L] = v.wtarget[2 * L + 1] = -1;
+    }
+    for (int L = 0; L < lines; L++) if (v.active[L]) vogel_refresh(&v, L);
+    if (deadline_tick(&ws->deadline, 2LL * m * n)) { seed_finish_early(m, n, cost, alloc, v.rem, ws); return; }
+
+    while (v.hsize > 0) {
+        // Satu alokasi menghabiskan satu line dan menyegarkan line yang mengawasinya: dihitung m + n unit
+        if (deadline_tick(&ws->deadline, lines)) { seed_finish_early(m, n, cost, alloc, v.rem, ws); return; }
+        int L = v.heap[0], t = vogel_target(&v, L, v.p1[L]);
+        int i = L < m ? L : t, j = L < m ? t - m : L - m;
+        seed_allocate(n, alloc, v.rem, m, i, j);
+        if (v.rem[i] == 0) vogel_retire(&v, i);
+        if (v.rem[m + j] == 0) vogel_retire(&v, m + j);
+    }
+}
+
+/* Russell: u_i / v_j = cost maksimum di antara sel aktif baris/kolom (dari ujung urutan cost), delta =
+ * c_ij - u_i - v_j, pilih delta paling negatif. Line yang habis hanya menurunkan u/v sehingga delta hanya naik:
+ * entri heap adalah batas bawah, cukup dihitung ulang saat berada di puncak (lazy) dan didorong turun jika naik. */
+static bool russell_less(const RussellEntry *a, const RussellEntry *b) {
+    return a->key < b->key || (a->key == b->key && a->cell < b->cell);
+}
+
+static void russell_sift_down(RussellEntry *h, size_t size, size_t k) {
+    RussellEntry e = h[k];
+    for (;;) {
+        size_t c = 2 * k + 1;
+        if (c >= size) break;
+        if (c + 1 < size && russell_less(&h[c + 1], &h[c])) c++;
+        if (!russell_less(&h[c], &e)) break;
+        h[k] = h[c];
+        k = c;
+    }
+    h[k] = e;
+}
+
+/* Cost lawan aktif termahal untuk line L; q[L] = posisinya pada urutan cost line L (mundur dari belakang,
+ * melewati lawan yang sudah habis). Dipanggil hanya jika line L masih punya lawan aktif. */
+static long long russell_line_max(int m, int n, int cost[m][n], const int *row_order, const int *col_order,
+                                  const int *active, int *q, int L) {
+    if (L < m) {
+        const int *ord = row_order + (size_t)L * n;
+        while (!active[m + ord[q[L]]]) q[L]--;
+        return cost[L][ord[q[L]]];
+    }
+    const int *ord = col_order + (size_t)(L - m) * m;
+    while (!active[ord[q[L]]]) q[L]--;
+    return cost[ord[q[L]]][L - m];
+}
+
+static void seed_russell(int m, int n, int cost[m][n], int supply[m], int demand[n], int alloc[m][n],
+                         const SsmOptions *opt, SsmWorkspace *ws) {
+    (void)opt;
+    int lines = m + n, *rem = ws->seed_lines, *active = rem + lines, *q = rem + 2 * lines;
+    int rows_left, cols_left;
+    seed_begin(m, n, supply, demand, alloc, rem, active, &rows_left, &cols_left);
+    if (ws->shared == NULL) {
+        row_order_build(m, n, cost, ws->row_order, ws->corder.keys);
+        cost_order_build(m, n, cost, &ws->corder);
+    }
+    const int *row_order = ws->row_order, *col_order = ws->corder.order;
+
+    for (int i = 0; i < m; i++) q[i] = n - 1;
+    for (int j = 0; j < n; j++) q[m + j] = m - 1;
+    if (rows_left == 0 || cols_left == 0) return;
+
+    RussellEntry *h = ws->rheap;
+    size_t size = 0;
+    for (int i = 0; i < m; i++) {
+        if (!active[i]) continue;
+        long long u = russell_line_max(m, n, cost, row_order, col_order, active, q, i);
+        for (int j = 0; j < n; j++) {
+            if (!active[m + j]) continue;
+            h[size].key = (long long)cost[i][j] - u - russell_line_max(m, n, cost, row_order, col_order, active, q, m + j);
+            h[size].cell = i * n + j;
+            size++;
+        }
+    }
+    for (size_t k = size / 2; k-- > 0;) russell_sift_down(h, size, k);
+    if (deadline_tick(&ws->deadline, 2LL * m * n)) { seed_finish_early(m, n, cost, alloc, rem, ws); return; }
+
+    while (size > 0 && rows_left > 0 && cols_left > 0) {
+        if (deadline_tick(&ws->deadline, 1)) { seed_finish_early(m, n, cost, alloc, rem, ws); return; }
+        int i = h[0].cell / n, j = h[0].cell % n;
+        if (!active[i] || !active[m + j]) {
+            h[0] = h[--size];
+            russell_sift_down(h, size, 0);
+            continue;
+        }
+        long long key = (long long)cost[i][j] - russell_line_max(m, n, cost, row_order, col_order, active, q, i)
+                       - russell_line_max(m, n, cost, row_order, col_order, active, q, m + j);
+        if (key > h[0].key) {
+            h[0].key = key;
+            russell_sift_down(h, size, 0);
+            continue;
+        }
+        seed_allocate(n, alloc, rem, m, i, j);
+        if (rem[i] == 0) { active[i] = 0; rows_left--; }
+        if (rem[m + j] == 0) { active[m + j] = 0; cols_left--; }
+        h[0] = h[--size];
+        russell_sift_down(h, size, 0);
+    }
+}
+
+typedef struct {
+    SeedStrategy id;
+    const char *name;
+    SeedFn fn;
+} SeedStrategyDesc;
+
+static const SeedStrategyDesc seed_strategies[] = {
+    { SEED_SSM, "ssm", make_feasible_ssm },
+    { SEED_LEAST_COST, "least-cost", seed_least_cost },
+    { SEED_VOGEL, "vogel", seed_vogel },
+    { SEED_RUSSELL, "russell", seed_russell },
+};
+
+/* Bangun solusi awal sesuai opt->seed (ws harus disiapkan dengan opsi yang sama) */
+static void build_initial_solution(int m, int n, int cost[m][n], int supply[m], int demand[n], int alloc[m][n],
+                                   const SsmOptions *opt, SsmWorkspace *ws) {
+    const SeedStrategyDesc *sd = &seed_strategies[opt->seed];
+    sd->fn(m, n, cost, supply, demand, alloc, opt, ws);
+    if (LOG_STEPS && opt->seed != SEED_SSM) {
+        printf("\n=== SEED %s ===\n", sd->name);
+        print_alloc_matrix_int(m, n, alloc);
+        printf("   Total cost seed = %lld\n", total_biaya(m, n, cost, alloc));
+    }
+}
+
+/* ==================== Fase eksak: network simplex dengan potensial u-v (MODI) ==================== */
+
+static int ns_cost(int m, int n, int cost[m][n], int i, int j) {
+    (void)m;
+    return j < n ? cost[i][j] : 0; // kolom n = kolom dummy untuk sisa supply
+}
+
+/* Sambungkan / lepaskan node dari daftar anak parent-nya */
+static void ns_attach_child(NsTree *t, int v, int p) {
+    t->prev_sib[v] = -1;
+    t->next_sib[v] = t->first_child[p];
+    if (t->first_child[p] >= 0) t->prev_sib[t->first_child[p]] = v;
+    t->first_child[p] = v;
+}
+
+static void ns_detach_child(NsTree *t, int v) {
+    int p = t->parent[v];
+    if (t->prev_sib[v] >= 0) t->next_sib[t->prev_sib[v]] = t->next_sib[v];
+    else t->first_child[p] = t->next_sib[v];
+    if (t->next_sib[v] >= 0) t->prev_sib[t->next_sib[v]] = t->prev_sib[v];
+}
+
+/* Hitung ulang depth, potensial dan thread (preorder) untuk subtree di bawah root.
+ * Kembalikan node terakhir subtree dalam urutan thread; thread node terakhir diisi pemanggil. */
+static int ns_rebuild_subtree(NsTree *t, int root) {
+    int top = 0, prev = -1;
+    t->stack[top++] = root;
+    while (top > 0) {
+        int v = t->stack[--top];
+        int p = t->parent[v];
+        if (p < 0) {
+            t->depth[v] = 0;
+            t->pi[v] = 0;
+        } else {
+            t->depth[v] = t->depth[p] + 1;
+            t->pi[v] = t->arc_cost[v] - t->pi[p]; // arc basis: u_i + v_j = c_ij
+        }
+        if (prev >= 0) { t->thread[prev] = v; t->rev_thread[v] = prev; }
+        prev = v;
+        for (int c = t->first_child[v]; c >= 0; c = t->next_sib[c]) t->stack[top++] = c;
+    }
+    return prev;
+}
+
+/* Arc sementara saat membangun basis awal dari alokasi SSM */
+typedef struct {
+    int r, c;  // baris, kolom (c == n untuk kolom dummy)
+    int x;     // flow
+    bool alive;
+} NsEdge;
+
+static int uf_find(int *uf, int v) {
+    while (uf[v] != v) { uf[v] = uf[uf[v]]; v = uf[v]; }
+    return v;
+}
+
+/* Bangun spanning tree basis dari alokasi. Sel positif yang membentuk cycle dihilangkan dengan
+ * menggeser flow ke arah yang tidak menaikkan biaya; komponen yang terpisah (degenerate)
+ * disambung dengan arc ber-flow 0 (baris sebagai parent jika memungkinkan). */
+static bool ns_build_from_alloc(int m, int n, int cost[m][n], int alloc[m][n], int supply[m], NsTree *t,
+                                int *cycles_removed, int *zero_arcs) {
+    int n2 = t->n2, N = m + n2;
+    size_t cap = (size_t)N + (size_t)m; // arc penyambung + arc kolom dummy
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+            if (alloc[i][j] > 0) cap++;
+
+    NsEdge *edges = malloc(cap * sizeof(NsEdge));
+    int *adj_head = malloc((size_t)N * sizeof(int));
+    int *adj_next = malloc(2 * cap * sizeof(int));
+    int *adj_edge = malloc(2 * cap * sizeof(int));
+    int *uf = malloc((size_t)N * sizeof(int));
+    int *pred = malloc((size_t)N * sizeof(int));
+    int *seen = malloc((size_t)N * sizeof(int));
+    int *queue = malloc((size_t)N * sizeof(int));
+    bool ok = edges && adj_head && adj_next && adj_edge && uf && pred && seen && queue;
+    int ne = 0, nadj = 0, alive = 0;
+    *cycles_removed = 0;
+    *zero_arcs = 0;
+
+    if (ok) {
+        for (int v = 0; v < N; v++) { adj_head[v] = -1; uf[v] = v; seen[v] = -1; }
+        for (int i = 0; i < m && ok; i++) {
+            int row_sum = 0;
+            for (int j = 0; j <= n; j++) {
+                int x;
+                if (j < n) { x = alloc[i][j]; row_sum += x; }
+                else if (n2 > n) x = supply[i] - row_sum; // sisa supply ke kolom dummy
+                else break;
+                if (x <= 0) continue;
+                int a = i, b = m + j;
+                edges[ne] = (NsEdge){ i, j, x, true };
+                int e = ne++;
+                if (uf_find(uf, a) != uf_find(uf, b)) {
+                    uf[uf_find(uf, a)] = uf_find(uf, b);
+                } else {
+                    // Cycle: cari path b -> a di forest lewat BFS
+                    int qh = 0, qt = 0;
+                    queue[qt++] = b; seen[b] = e; pred[b] = -1;
+                    while (qh < qt && seen[a] != e) {
+                        int v = queue[qh++];
+                        for (int k = adj_head[v]; k >= 0; k = adj_next[k]) {
+                            int f = adj_edge[k];
+                            if (!edges[f].alive) continue;
+                            int w = (v < m) ? m + edges[f].c : edges[f].r;
+                            if (seen[w] == e) continue;
+                            seen[w] = e; pred[w] = f; queue[qt++] = w;
+                        }
+                    }
+                    // Sisi path dari b ke a: tanda -, +, -, ... (flow sel baru bertanda +)
+                    long long d = ns_cost(m, n, cost, i, j);
+                    int sign = 1;
+                    for (int v = a; v != b; ) {
+                        int f = pred[v];
+                        sign = -sign; // dari ujung a, arc pertama bertanda - (berselang-seling)
+                        d += sign * (long long)ns_cost(m, n, cost, edges[f].r, edges[f].c);
+                        v = (v < m) ? m + edges[f].c : edges[f].r;
+                    }
+                    bool plus = d <= 0;
+                    int theta = plus ? INT_MAX : x;
+                    sign = 1;
+                    for (int v = a; v != b; ) {
+                        int f = pred[v];
+                        sign = -sign;
+                        if ((plus && sign < 0) || (!plus && sign > 0))
+                            if (edges[f].x < theta) theta = edges[f].x;
+                        v = (v < m) ? m + edges[f].c : edges[f].r;
+                    }
+                    int dir = plus ? 1 : -1;
+                    edges[e].x += dir * theta;
+                    int removed = edges[e].x == 0 ? e : -1;
+                    sign = 1;
+                    for (int v = a; v != b; ) {
+                        int f = pred[v];
+                        sign = -sign;
+                        edges[f].x += dir * sign * theta;
+                        if (edges[f].x == 0 && removed < 0) removed = f;
+                        v = (v < m) ? m + edges[f].c : edges[f].r;
+                    }
+                    (*cycles_removed)++;
+                    edges[removed].alive = false;
+                    // Sel lain yang sempat menjadi 0 tetap di forest sebagai arc degenerate
+                    if (removed == e) continue;
+                }
+                adj_edge[nadj] = e; adj_next[nadj] = adj_head[a]; adj_head[a] = nadj++;
+                adj_edge[nadj] = e; adj_next[nadj] = adj_head[b]; adj_head[b] = nadj++;
+            }
+        }
+
+        // Sambungkan komponen yang terpisah dengan arc ber-flow 0
+        for (int j = 0; j < n2; j++) {
+            if (uf_find(uf, m + j) == uf_find(uf, 0)) continue;
+            int best_r = -1;
+            for (int i = 0; i < m; i++)
+                if (uf_find(uf, i) == uf_find(uf, 0) &&
+                    (best_r < 0 || ns_cost(m, n, cost, i, j) < ns_cost(m, n, cost, best_r, j))) best_r = i;
+            edges[ne] = (NsEdge){ best_r, j, 0, true };
+            uf[uf_find(uf, m + j)] = uf_find(uf, 0);
+            adj_edge[nadj] = ne; adj_next[nadj] = adj_head[best_r]; adj_head[best_r] = nadj++;
+            adj_edge[nadj] = ne; adj_next[nadj] = adj_head[m + j]; adj_head[m + j] = nadj++;
+            ne++; (*zero_arcs)++;
+        }
+        for (int i = 0; i < m; i++) {
+            if (uf_find(uf, i) == uf_find(uf, 0)) continue;
+            int best_c = 0;
+            for (int j = 1; j < n2; j++)
+                if (ns_cost(m, n, cost, i, j) < ns_cost(m, n, cost, i, best_c)) best_c = j;
+            edges[ne] = (NsEdge){ i, best_c, 0, true };
+            uf[uf_find(uf, i)] = uf_find(uf, 0);
+            adj_edge[nadj] = ne; adj_next[nadj] = adj_head[i]; adj_head[i] = nadj++;
+            adj_edge[nadj] = ne; adj_next[nadj] = adj_head[m + best_c]; adj_head[m + best_c] = nadj++;
+            ne++; (*zero_arcs)++;
+        }
+        for (int e = 0; e < ne; e++) if (edges[e].alive) alive++;
+        ok = alive == N - 1;
+    }
+
+    if (ok) {
+        // Orientasikan pohon dari root (baris 0)
+        for (int v = 0; v < N; v++) { t->parent[v] = -1; t->first_child[v] = -1; seen[v] = 0; }
+        int qh = 0, qt = 0;
+        queue[qt++] = 0; seen[0] = 1;
+        while (qh < qt) {
+            int v = queue[qh++];
+            for (int k = adj_head[v]; k >= 0; k = adj_next[k]) {
+                int f = adj_edge[k];
+                if (!edges[f].alive) continue;
+                int w = (v < m) ? m + edges[f].c : edges[f].r;
+                if (seen[w]) continue;
+                seen[w] = 1;
+                t->parent[w] = v;
+                t->flow[w] = edges[f].x;
+                t->arc_cost[w] = ns_cost(m, n, cost, edges[f].r, edges[f].c);
+                ns_attach_child(t, w, v);
+                queue[qt++] = w;
+            }
+        }
+        ok = qt == N;
+        if (ok) {
+            int last = ns_rebuild_subtree(t, 0);
+            t->thread[last] = -1;
+            t->rev_thread[0] = -1;
+        }
+    }
+
+    free(edges); free(adj_head); free(adj_next); free(adj_edge);
+    free(uf); free(pred); free(seen); free(queue);
+    return ok;
+}
+
+/* Block pricing: cari arc non-basis dengan reduced cost c_ij - u_i - v_j negatif, mulai dari baris
+ * terakhir yang dipakai. Berhenti di akhir blok pertama yang memuat kandidat negatif. */
+static bool ns_find_entering(NsTree *t, int m, int n, int cost[m][n], int *ei, int *ej) {
+    int n2 = t->n2;
+    long long block = t->block, best = 0, scanned = 0;
+    int start = t->next_row;
+    for (int k = 0; k < m; k++) {
+        int i = start + k < m ? start + k : start + k - m;
+        long long ui = t->pi[i];
+        const long long *vj = t->pi + m;
+        for (int j = 0; j < n; j++) {
+            long long rc = cost[i][j] - ui - vj[j];
+            if (rc < best) { best = rc; *ei = i; *ej = j; }
+        }
+        if (n2 > n && -ui - vj[n] < best) { best = -ui - vj[n]; *ei = i; *ej = n; }
+        scanned += n2;
+        if (scanned >= block && best < 0) {
+            t->next_row = i + 1 < m ? i + 1 : 0;
+            return true;
+        }
+    }
+    return best < 0;
+}
+
+/* Satu pivot: arc (ei, ej) dengan biaya c_in masuk basis. Arc keluar dipilih dengan aturan strongly
+ * feasible (arc pemblokir terakhir pada cycle, dihitung dari join node) untuk menghindari cycling
+ * pada pivot degenerate. Kembalikan theta. */
+static int ns_pivot(NsTree *t, int m, int ei, int ej, long long c_in) {
+    int a = ei, b = m + ej;
+
+    int u = a, v = b;
+    while (u != v) {
+        if (t->depth[u] > t->depth[v]) u = t->parent[u];
+        else if (t->depth[v] > t->depth[u]) v = t->parent[v];
+        else { u = t->parent[u]; v = t->parent[v]; }
+    }
+    int join = u;
+
+    // Sisi baris (a): arc yang berkurang adalah arc dengan child baris. Sisi kolom (b): child kolom.
+    int delta = INT_MAX, u_out = -1, side = 0;
+    for (u = a; u != join; u = t->parent[u])
+        if (u < m && t->flow[u] < delta) { delta = t->flow[u]; u_out = u; side = 1; }
+    for (u = b; u != join; u = t->parent[u])
+        if (u >= m && t->flow[u] <= delta) { delta = t->flow[u]; u_out = u; side = 2; }
+
+    int theta = delta;
+    if (theta > 0) {
+        for (u = a; u != join; u = t->parent[u]) t->flow[u] += (u < m) ? -theta : theta;
+        for (u = b; u != join; u = t->parent[u]) t->flow[u] += (u >= m) ? -theta : theta;
+    }
+
+    int q = side == 1 ? a : b; // ujung arc masuk yang ikut terlepas bersama subtree u_out
+    int p = side == 1 ? b : a;
+
+    // Keluarkan range preorder subtree u_out dari thread
+    int end = u_out;
+    while (t->thread[end] >= 0 && t->depth[t->thread[end]] > t->depth[u_out]) end = t->thread[end];
+    int before = t->rev_thread[u_out], after = t->thread[end];
+    t->thread[before] = after;
+    if (after >= 0) t->rev_thread[after] = before;
+
+    // Balik arah path q -> u_out sehingga q menjadi root subtree, lalu gantung di bawah p
+    ns_detach_child(t, u_out);
+    int x = q, new_par = p, new_flow = theta;
+    long long new_cost = c_in;
+    while (true) {
+        int old_par = t->parent[x], old_flow = t->flow[x];
+        long long old_cost = t->arc_cost[x];
+        if (x != u_out) ns_detach_child(t, x);
+        t->parent[x] = new_par;
+        t->flow[x] = new_flow;
+        t->arc_cost[x] = new_cost;
+        ns_attach_child(t, x, new_par);
+        if (x == u_out) break;
+        new_par = x; new_flow = old_flow; new_cost = old_cost; x = old_par;
+    }
+
+    // Hitung ulang depth/potensial subtree dan sisipkan preorder-nya tepat setelah p
+    int last = ns_rebuild_subtree(t, q);
+    after = t->thread[p];
+    t->thread[p] = q; t->rev_thread[q] = p;
+    t->thread[last] = after;
+    if (after >= 0) t->rev_thread[after] = last;
+    return theta;
+}
+
+/* Fase akhir: mulai dari alokasi SSM (harus feasible), pivot sampai semua reduced cost >= 0 */
+static bool solve_exact_network_simplex(int m, int n, int cost[m][n], int supply[m], int demand[n], int alloc[m][n],
+                                        SsmWorkspace *ws) {
+    NsTree *t = &ws->ns;
+    long long sum_s = 0, sum_d = 0;
+    for (int i = 0; i < m; i++) sum_s += supply[i];
+    for (int j = 0; j < n; j++) sum_d += demand[j];
+
+    if (LOG_STEPS) printf("\n=== EXACT PHASE (NETWORK SIMPLEX): START ===\n");
+
+    // Basis awal hanya bisa dibangun dari alokasi yang feasible
+    bool feasible = sum_s >= sum_d && t->parent != NULL;
+    for (int j = 0; j < n && feasible; j++) {
+        long long col = 0;
+        for (int i = 0; i < m; i++) { if (alloc[i][j] < 0) feasible = false; col += alloc[i][j]; }
+        if (col != demand[j]) feasible = false;
+    }
+    for (int i = 0; i < m && feasible; i++) {
+        long long row = 0;
+        for (int j = 0; j < n; j++) row += alloc[i][j];
+        if (row > supply[i]) feasible = false;
+    }
+    if (!feasible) {
+        printf("Peringatan: alokasi belum feasible (atau supply < demand), fase eksak dilewati.\n");
+        return false;
+    }
+
+    t->m = m; t->n = n;
+    t->n2 = sum_s > sum_d ? n + 1 : n;
+    t->next_row = 0;
+    t->block = 10; // ukuran blok pricing ~ sqrt(jumlah arc)
+    while (t->block * t->block < (long long)m * t->n2) t->block++;
+    int cycles_removed = 0, zero_arcs = 0;
+    if (!ns_build_from_alloc(m, n, cost, alloc, supply, t, &cycles_removed, &zero_arcs)) {
+        printf("Peringatan: gagal membangun basis awal, fase eksak dilewati.\n");
+        return false;
+    }
+    if (LOG_STEPS) printf("Basis awal: %d cycle dihapus, %d arc degenerate (flow 0) ditambahkan.\n",
+                        cycles_removed, zero_arcs);
+
+    long long pivots = 0, degenerate = 0;
+    const long long max_pivots = 1000LL * (m + t->n2) + 100000;
+    int ei = 0, ej = 0;
+    while (ns_find_entering(t, m, n, cost, &ei, &ej)) {
+        if (pivots >= max_pivots) {
+            printf("Peringatan: fase eksak mencapai batas %lld pivot.\n", max_pivots);
+            break;
+        }
+        // Setiap basis adalah alokasi feasible dan pivot tidak menaikkan cost, jadi berhenti di sini aman
+        if (deadline_tick(&ws->deadline, m + t->n2)) {
+            if (LOG_STEPS) printf("Batas waktu/kerja habis setelah %lld pivot. Fase eksak dihentikan.\n", pivots);
+            ws->metrics.early_stop = true;
+            ws->metrics.stop_phase = PHASE_EXACT;
+            break;
+        }
+        if (ns_pivot(t, m, ei, ej, ns_cost(m, n, cost, ei, ej)) == 0) degenerate++;
+        pivots++;
+        TRACE(ws->trace, TR_NS_PIVOT, (int32_t)pivots, ei, ej);
+    }
+    ws->metrics.ns_pivots = pivots;
+
+    // Tulis flow pohon basis kembali ke matriks alokasi (kolom dummy diabaikan). Sel lama dikosongkan lewat
+    // daftar sel sehingga alloc dan daftar tetap sinkron (dipakai lagi oleh re-solve warm start).
+    CellLists *cl = &ws->cells;
+    for (int i = 0; i < m; i++)
+        while (cl->row_head[i] >= 0) {
+            int c = cl->nodes[cl->row_head[i]].c;
+            cells_add(cl, m, n, alloc, i, c, -alloc[i][c]);
+        }
+    for (int v = 1; v < m + t->n2; v++) {
+        int p = t->parent[v];
+        int r = v < m ? v : p, c = v < m ? p - m : v - m;
+        if (c < n && t->flow[v] > 0) cells_add(cl, m, n, alloc, r, c, t->flow[v]);
+    }
+
+    if (LOG_STEPS) {
+        printf("Pivot: %lld (degenerate: %lld). Total cost = %lld\n", pivots, degenerate, total_biaya(m, n, cost, alloc));
+        print_alloc_matrix_int(m, n, alloc);
+        printf("=== EXACT PHASE (NETWORK SIMPLEX): END ===\n");
+    }
+    return true;
+}
+
+/* ==================== Re-solve warm start ==================== */
+
+/* Perubahan kecil pada instance yang sudah diselesaikan: nilai baru untuk supply[i], demand[j] atau cost[i][j] */
+typedef enum { CHANGE_SUPPLY = 0, CHANGE_DEMAND, CHANGE_COST } SsmChangeKind;
+
+typedef struct {
+    SsmChangeKind kind;
+    int i, j;            // i untuk supply/cost, j untuk demand/cost
+    int value;
+} SsmChange;
+
+/* Best-improvement hanya atas rectangle yang memuat minimal satu baris kotor: tiap sel donor di baris kotor
+ * dipasangkan dengan semua sel donor di baris lain (O(sel baris kotor x B)). Rectangle dengan dua baris bersih
+ * tidak berubah sejak solve sebelumnya, jadi tetap tidak memperbaiki. */
+static RectMove search_rectangles_dirty(int m, int n, int cost[m][n], const CellLists *cl, const int *rows, int nrows,
+                                        long long *evaluated) {
+    RectMove best = no_rect_move;
+    for (int t = 0; t < nrows; t++) {
+        int d = rows[t];
+        for (int ka = cl->row_head[d]; ka >= 0; ka = cl->nodes[ka].rnext) {
+            int cd = cl->nodes[ka].c;
+            for (int r = 0; r < m; r++) {
+                if (r == d) continue;
+                for (int kb = cl->row_head[r]; kb >= 0; kb = cl->nodes[kb].rnext) {
+                    int cr = cl->nodes[kb].c;
+                    if (cr == cd) continue;
+                    RectMove cand = d < r ? rect_from_donors(m, n, cost, d, cd, r, cr)
+                                          : rect_from_donors(m, n, cost, r, cr, d, cd);
+                    (*evaluated)++;
+                    if (cand.delta < 0 && rect_move_better(&cand, &best)) best = cand;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+/* Cek semua perubahan sebelum ada yang diterapkan: indeks dalam batas, supply/demand baru tidak negatif, dan total
+ * supply >= total demand setelah perubahan (untuk indeks yang sama, perubahan terakhir yang berlaku). Penanda
+ * warm_dirty/warm_cols harus nol saat masuk dan nol lagi saat keluar. */
+static bool warm_changes_valid(int m, int n, const int *supply, const int *demand, const SsmChange *changes,
+                               int nchanges, SsmWorkspace *ws) {
+    long long sum_s = 0, sum_d = 0;
+    bool ok = true;
+    for (int i = 0; i < m; i++) sum_s += supply[i];
+    for (int j = 0; j < n; j++) sum_d += demand[j];
+    for (int c = nchanges - 1; c >= 0 && ok; c--) {
+        const SsmChange *ch = &changes[c];
+        if (ch->kind == CHANGE_SUPPLY) {
+            ok = ch->i >= 0 && ch->i < m && ch->value >= 0;
+            if (ok && !ws->warm_dirty[ch->i]) { ws->warm_dirty[ch->i] = 1; sum_s += ch->value - supply[ch->i]; }
+        } else if (ch->kind == CHANGE_DEMAND) {
+            ok = ch->j >= 0 && ch->j < n && ch->value >= 0;
+            if (ok && !ws->warm_cols[ch->j]) { ws->warm_cols[ch->j] = 1; sum_d += ch->value - demand[ch->j]; }
+        } else {
+            ok = ch->kind == CHANGE_COST && ch->i >= 0 && ch->i < m && ch->j >= 0 && ch->j < n;
+        }
+    }
+    for (int c = 0; c < nchanges; c++) {
+        const SsmChange *ch = &changes[c];
+        if (ch->kind == CHANGE_SUPPLY && ch->i >= 0 && ch->i < m) ws->warm_dirty[ch->i] = 0;
+        if (ch->kind == CHANGE_DEMAND && ch->j >= 0 && ch->j < n) ws->warm_cols[ch->j] = 0;
+    }
+    return ok && sum_s >= sum_d;
+}
+
+/* Re-solve setelah perubahan kecil. Prasyarat: alloc dan ws->cells berasal dari solve sebelumnya atas instance
+ * yang sama (solve_instance atau ssm_resolve_warm). Perubahan divalidasi dulu (warm_changes_valid); jika ada yang
+ * tidak valid, instance dan alokasi tidak disentuh sama sekali. Selain itu perubahan diterapkan ke
+ * cost/supply/demand, lalu:
+ *  1. kolom yang demand-nya turun melepas alokasi dari sel termahal,
+ *  2. baris yang supply-nya turun memindahkan kelebihan ke baris ber-sisa termurah di kolom yang sama,
+ *  3. kolom yang demand-nya naik diisi dari baris ber-sisa termurah,
+ *  4. perbaikan rectangle hanya di sekitar baris yang tersentuh (baris baru ikut kotor setelah tiap move).
+ * Biaya kerja sebanding dengan jumlah perubahan x O(m + B), bukan m x n (kecuali opt->exact). Tanpa opt->exact
+ * hasilnya optimum lokal yang bisa menjauh dari solve dingin seiring perubahan menumpuk (di --warm-bench 200x200
+ * sampai sekitar 4% setelah beberapa batch 64 perubahan); dengan opt->exact hasilnya sama dengan solve dingin.
+ * Kembalikan false jika perubahan tidak valid (indeks di luar batas, nilai negatif, total supply < total demand). */
+static bool ssm_resolve_warm(int m, int n, int cost[m][n], int supply[m], int demand[n], int alloc[m][n],
+                             const SsmChange *changes, int nchanges, const SsmOptions *opt, SsmWorkspace *ws) {
+    CellLists *cl = &ws->cells;
+    int *total = ws->total_alloc_baris, nrows = 0;
+    SsmMetrics *mt = &ws->metrics;
+    memset(mt, 0, sizeof *mt);
+    uint64_t t0 = now_ns();
+
+    memset(ws->warm_dirty, 0, (size_t)m * sizeof(int));
+    memset(ws->warm_cols, 0, (size_t)n * sizeof(int));
+    if (!warm_changes_valid(m, n, supply, demand, changes, nchanges, ws)) {
+        mt->final_cost = cells_total_cost(m, n, cost, alloc, cl);
+        if (LOG_STEPS) printf("[warm start] %d perubahan ditolak (tidak valid), instance tidak diubah\n", nchanges);
+        return false;
+    }
+    for (int i = 0; i < m; i++) {
+        total[i] = 0;
+        for (int k = cl->row_head[i]; k >= 0; k = cl->nodes[k].rnext) total[i] += alloc[i][cl->nodes[k].c];
+    }
+    for (int c = 0; c < nchanges; c++) {
+        const SsmChange *ch = &changes[c];
+        if (ch->kind == CHANGE_SUPPLY) { supply[ch->i] = ch->value; warm_mark_row(ws, &nrows, ch->i); }
+        else if (ch->kind == CHANGE_DEMAND) demand[ch->j] = ch->value;
+        else { cost[ch->i][ch->j] = ch->value; warm_mark_row(ws, &nrows, ch->i); }
+    }
+
+    // Setelah validasi total supply >= total demand, jadi langkah 2 dan 3 selalu menemukan baris ber-sisa;
+    // feasible hanya penjaga.
+    bool feasible = true;
+    // 1. Demand turun: lepas dari sel termahal di kolom tersebut
+    for (int c = 0; c < nchanges; c++) {
+        if (changes[c].kind != CHANGE_DEMAND) continue;
+        int j = changes[c].j, col = 0;
+        for (int k = cl->col_head[j]; k >= 0; k = cl->nodes[k].cnext) col += alloc[cl->nodes[k].r][j];
+        while (col > demand[j]) {
+            int r = warm_most_expensive(m, n, cost, cl, false, j);
+            int x = alloc[r][j] < col - demand[j] ? alloc[r][j] : col - demand[j];
+            cells_add(cl, m, n, alloc, r, j, -x);
+            total[r] -= x; col -= x;
+            warm_mark_row(ws, &nrows, r);
+        }
+    }
+    // 2. Supply turun di bawah alokasi: pindahkan kelebihan dari sel termahal ke baris ber-sisa termurah
+    for (int c = 0; c < nchanges && feasible; c++) {
+        if (changes[c].kind != CHANGE_SUPPLY) continue;
+        feasible = warm_shed_row_excess(m, n, cost, supply, alloc, total, changes[c].i, ws, &nrows);
+    }
+    // 3. Demand naik: isi dari baris ber-sisa termurah
+    for (int c = 0; c < nchanges && feasible; c++) {
+        if (changes[c].kind != CHANGE_DEMAND) continue;
+        int j = changes[c].j, col = 0;
+        for (int k = cl->col_head[j]; k >= 0; k = cl->nodes[k].cnext) col += alloc[cl->nodes[k].r][j];
+        while (col < demand[j]) {
+            int r = warm_cheapest_slack_row(m, n, cost, supply, total, j, -1);
+            if (r < 0) { feasible = false; break; }
+            int x = demand[j] - col < supply[r] - total[r] ? demand[j] - col : supply[r] - total[r];
+            cells_add(cl, m, n, alloc, r, j, x);
+            total[r] += x; col += x;
+            warm_mark_row(ws, &nrows, r);
+        }
+    }
+    uint64_t t1 = now_ns();
+    mt->seed_ns = t1 - t0;
+
+    // 4. Perbaikan rectangle lokal di sekitar baris kotor
+    int iter = 0;
+    while (feasible) {
+        RectMove best = search_rectangles_dirty(m, n, cost, cl, ws->warm_rows, nrows, &mt->rect_evaluated);
+        if (best.delta >= 0) break;
+        iter++;
+        int theta = apply_rectangle_move(m, n, cost, alloc, cl, &best, iter);
+        mt->rect_moves++;
+        mt->theta_moved += theta;
+        TRACE(ws->trace, TR_RECT_MOVE, iter, best.r1, best.c1, best.r2, best.c2, best.delta, theta, best.type2);
+        warm_mark_row(ws, &nrows, best.r1);
+        warm_mark_row(ws, &nrows, best.r2);
+    }
+    for (int t = 0; t < nrows; t++) ws->warm_dirty[ws->warm_rows[t]] = 0;
+    uint64_t t2 = now_ns();
+    mt->rect_ns = t2 - t1;
+
+    if (feasible && opt->exact) {
+        solve_exact_network_simplex(m, n, cost, supply, demand, alloc, ws);
+        mt->exact_ns = now_ns() - t2;
+    }
+    mt->final_cost = cells_total_cost(m, n, cost, alloc, cl);
+    if (LOG_STEPS) printf("[warm start] %d perubahan, %d baris tersentuh, %d move rectangle, cost = %lld%s\n",
+                        nchanges, nrows, iter, mt->final_cost, feasible ? "" : " (TIDAK FEASIBLE)");
+    return feasible;
+}
+
+/* Waktu monotonic dalam detik */
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* splitmix64: generator acak kecil yang deterministik untuk instance benchmark */
+static uint64_t rng_next(uint64_t *s) {
+    uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static int rng_range(uint64_t *s, int lo, int hi) {
+    return lo + (int)(rng_next(s) % (uint64_t)(hi - lo + 1));
+}
+
+/* Jenis instance sintetis untuk benchmark */
+typedef enum {
+    GEN_UNIFORM = 0, // cost acak seragam 1..1000
+    GEN_CLUSTERED,   // baris/kolom dibagi ke cluster: murah di dalam cluster, mahal antar cluster
+    GEN_GEOMETRIC,   // cost = jarak euclid antara titik sumber dan tujuan acak di bidang 1000x1000
+    GEN_DEGENERATE,  // supply/demand seragam dan cost dengan banyak nilai sama (basis sangat degenerate)
+    GEN_TYPE_COUNT
+} GenType;
+
+static const char *const gen_type_names[GEN_TYPE_COUNT] = { "uniform", "clustered", "geometric", "degenerate" };
+
+static int isqrt_ll(long long x) {
+    if (x <= 0) return 0;
+    long long r = x, y = (x + 1) / 2;
+    while (y < r) { r = y; y = (r + x / r) / 2; } // Newton, turun monoton ke floor(sqrt(x))
+    return (int)r;
+}
+
+// Koordinat titik (0..1000) untuk sisi 0 = sumber / 1 = tujuan, indeks idx, sumbu 0 = x / 1 = y
+static int gen_coord(uint64_t seed, int side, int idx, int axis) {
+    uint64_t s = seed ^ ((uint64_t)(2 * idx + axis) << 1 | (uint64_t)side) * 0xD1B54A32D192ED03ull;
+    return rng_range(&s, 0, 1000);
+}
+
+/* Instance seimbang (total supply = total demand), deterministik untuk (type, m, n, seed) */
+static void generate_instance(GenType type, int m, int n, int cost[m][n], int supply[m], int demand[n], uint64_t seed) {
+    uint64_t s = seed;
+    long long total = 0;
+    switch (type) {
+    case GEN_CLUSTERED: {
+        int k = 2 + (m + n) / 100; // jumlah cluster tumbuh pelan dengan ukuran
+        for (int i = 0; i < m; i++)
+            for (int j = 0; j < n; j++)
+                cost[i][j] = (i % k == j % k) ? rng_range(&s, 1, 50) : rng_range(&s, 400, 1000);
+        break;
+    }
+    case GEN_GEOMETRIC:
+        for (int i = 0; i < m; i++) {
+            long long xi = gen_coord(seed, 0, i, 0), yi = gen_coord(seed, 0, i, 1);
+            for (int j = 0; j < n; j++) {
+                long long dx = xi - gen_coord(seed, 1, j, 0), dy = yi - gen_coord(seed, 1, j, 1);
+                cost[i][j] = 1 + isqrt_ll(dx * dx + dy * dy);
+            }
+        }
+        break;
+    case GEN_DEGENERATE:
+        for (int i = 0; i < m; i++)
+            for (int j = 0; j < n; j++)
+                cost[i][j] = rng_range(&s, 1, 5);
+        for (int i = 0; i < m; i++) supply[i] = 10 * n;
+        for (int j = 0; j < n; j++) demand[j] = 10 * m;
+        return;
+    default:
+        for (int i = 0; i < m; i++)
+            for (int j = 0; j < n; j++)
+                cost[i][j] = rng_range(&s, 1, 1000);
+        break;
+    }
+    for (int i = 0; i < m; i++) { supply[i] = rng_range(&s, 1, 100); total += supply[i]; }
+    for (int j = 0; j < n; j++) demand[j] = (int)(total / n) + (j < total % n ? 1 : 0);
+}
+
+static long peak_rss_kb(void) {
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return -1;
+    return ru.ru_maxrss;
+}
+
+/* ==================== Input instance: teks (parser cepat) dan biner (mmap) ==================== */
+
+/* Instance yang sudah dimuat. cost/supply/demand menunjuk ke workspace (input teks)
+ * atau langsung ke file biner yang di-mmap (tanpa salinan). Mapping-nya MAP_PRIVATE dan writable: penulisan
+ * (mis. perubahan warm start) hanya menyalin halaman yang disentuh, file di disk tidak pernah berubah. */
+typedef struct {
+    int m, n;
+    int *cost;      // m x n row-major
+    int *supply;    // m
+    int *demand;    // n
+    void *map;      // non-NULL jika data dibaca in-place dari file biner
+    size_t map_len;
+} SsmInstance;
+
+/* Format biner: header 32 byte, lalu cost (m*n), supply (m), demand (n) sebagai int32 little-endian */
+#define SSM_BIN_MAGIC "SSMB"
+#define SSM_BIN_VERSION 1u
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t m, n;
+    uint32_t elem_width;  // byte per elemen, saat ini hanya 4 (int32)
+    uint32_t reserved[3];
+} SsmBinHeader;
+
+static void instance_release(SsmInstance *inst) {
+    if (inst->map != NULL) munmap(inst->map, inst->map_len);
+    inst->map = NULL;
+    inst->map_len = 0;
+}
+
+/* Parser teks berbasis buffer: seluruh file dibaca sekali, angka di-parse manual tanpa fscanf */
+typedef struct {
+    const char *p, *end;
+} TextCursor;
+
+static bool text_next_int(TextCursor *tc, int *out) {
+    const char *p = tc->p, *end = tc->end;
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t' || *p == '\v' || *p == '\f')) p++;
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+')) { neg = (*p == '-'); p++; }
+    if (p >= end || (unsigned)(*p - '0') > 9) { tc->p = p; return false; }
+    long long v = 0;
+    while (p < end && (unsigned)(*p - '0') <= 9) {
+        v = v * 10 + (*p - '0');
+        if (v > (long long)INT_MAX + 1) { tc->p = p; return false; }
+        p++;
+    }
+    if (neg) v = -v;
+    if (v > INT_MAX) { tc->p = p; return false; }
+    *out = (int)v;
+    tc->p = p;
+    return true;
+}
+
+static char *read_whole_file(int fd, size_t *len) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 0) return NULL;
+    char *buf = malloc((size_t)st.st_size + 1);
+    if (buf == NULL) return NULL;
+    size_t got = 0;
+    while (got < (size_t)st.st_size) {
+        ssize_t r = read(fd, buf + got, (size_t)st.st_size - got);
+        if (r <= 0) break;
+        got += (size_t)r;
+    }
+    *len = got;
+    return buf;
+}
+
+static bool load_instance_text(int fd, SsmWorkspace *ws, const SsmOptions *opt, SsmInstance *inst) {
+    size_t len = 0;
+    char *buf = read_whole_file(fd, &len);
+    if (buf == NULL) return false;
+    TextCursor tc = { buf, buf + len };
+    int m, n;
+    bool ok = text_next_int(&tc, &m) && text_next_int(&tc, &n) && m > 0 && n > 0 &&
+              ssm_workspace_prepare(ws, m, n, opt, true);
+    if (ok) {
+        size_t mn = (size_t)m * (size_t)n;
+        for (size_t k = 0; ok && k < mn; k++) ok = text_next_int(&tc, &ws->cost[k]);
+        for (int i = 0; ok && i < m; i++) ok = text_next_int(&tc, &ws->supply[i]);
+        for (int j = 0; ok && j < n; j++) ok = text_next_int(&tc, &ws->demand[j]);
+    }
+    free(buf);
+    if (!ok) return false;
+    *inst = (SsmInstance){ m, n, ws->cost, ws->supply, ws->demand, NULL, 0 };
+    return true;
+}
+
+static bool load_instance_bin(int fd, SsmWorkspace *ws, const SsmOptions *opt, SsmInstance *inst) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SsmBinHeader)) return false;
+    size_t len = (size_t)st.st_size;
+    void *map = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) return false;
+
+    const SsmBinHeader *h = map;
+    size_t m = h->m, n = h->n;
+    bool ok = memcmp(h->magic, SSM_BIN_MAGIC, 4) == 0 && h->version == SSM_BIN_VERSION &&
+              h->elem_width == sizeof(int32_t) && m > 0 && n > 0 && m <= INT_MAX && n <= INT_MAX &&
+              len == sizeof(SsmBinHeader) + (m * n + m + n) * sizeof(int32_t);
+    if (ok) ok = ssm_workspace_prepare(ws, (int)m, (int)n, opt, false);
+    if (!ok) {
+        if (h->version != SSM_BIN_VERSION) fprintf(stderr, "File biner versi %u tidak didukung (atau beda endianness).\n", h->version);
+        munmap(map, len);
+        return false;
+    }
+    madvise(map, len, MADV_SEQUENTIAL);
+    int *data = (int *)((char *)map + sizeof(SsmBinHeader));
+    *inst = (SsmInstance){ (int)m, (int)n, data, data + m * n, data + m * n + m, map, len };
+    return true;
+}
+
+/* Muat instance dari file teks (format testcase/) atau biner (magic "SSMB") */
+static bool load_instance(const char *path, SsmWorkspace *ws, const SsmOptions *opt, SsmInstance *inst) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    char magic[4] = { 0 };
+    bool is_bin = pread(fd, magic, sizeof magic, 0) == (ssize_t)sizeof magic && memcmp(magic, SSM_BIN_MAGIC, 4) == 0;
+    bool ok = is_bin ? load_instance_bin(fd, ws, opt, inst) : load_instance_text(fd, ws, opt, inst);
+    close(fd);
+    return ok;
+}
+
+static bool write_instance_bin(const char *path, const SsmInstance *inst) {
+    FILE *out = fopen(path, "wb");
+    if (out == NULL) return false;
+    SsmBinHeader h = { { 'S', 'S', 'M', 'B' }, SSM_BIN_VERSION, (uint32_t)inst->m, (uint32_t)inst->n,
+                       (uint32_t)sizeof(int32_t), { 0, 0, 0 } };
+    size_t mn = (size_t)inst->m * (size_t)inst->n;
+    bool ok = fwrite(&h, sizeof h, 1, out) == 1 &&
+              fwrite(inst->cost, sizeof(int), mn, out) == mn &&
+              fwrite(inst->supply, sizeof(int), (size_t)inst->m, out) == (size_t)inst->m &&
+              fwrite(inst->demand, sizeof(int), (size_t)inst->n, out) == (size_t)inst->n;
+    return fclose(out) == 0 && ok;
+}
+
+/* Konversi file teks lama ke format biner */
+static int convert_to_bin(const char *in_path, const char *out_path) {
+    SsmWorkspace ws = { 0 };
+    SsmInstance inst;
+    if (!load_instance(in_path, &ws, &default_options, &inst)) {
+        fprintf(stderr, "Gagal membaca %s\n", in_path);
+        ssm_workspace_free(&ws);
+        return 1;
+    }
+    bool ok = write_instance_bin(out_path, &inst);
+    if (ok) printf("%s -> %s (%dx%d)\n", in_path, out_path, inst.m, inst.n);
+    else fprintf(stderr, "Gagal menulis %s\n", out_path);
+    instance_release(&inst);
+    ssm_workspace_free(&ws);
+    return ok ? 0 : 1;
+}
+
+/* Parser lama berbasis fscanf, hanya dipakai sebagai pembanding di --parse-bench */
+static bool load_instance_fscanf(const char *path, SsmWorkspace *ws, const SsmOptions *opt, SsmInstance *inst) {
+    FILE *in = fopen(path, "r");
+    if (in == NULL) return false;
+    int m, n;
+    bool ok = fscanf(in, "%d", &m) == 1 && fscanf(in, "%d", &n) == 1 && m > 0 && n > 0 &&
+              ssm_workspace_prepare(ws, m, n, opt, true);
+    size_t mn = ok ? (size_t)m * (size_t)n : 0;
+    for (size_t k = 0; ok && k < mn; k++) ok = fscanf(in, "%d", &ws->cost[k]) == 1;
+    for (int i = 0; ok && i < m; i++) ok = fscanf(in, "%d", &ws->supply[i]) == 1;
+    for (int j = 0; ok && j < n; j++) ok = fscanf(in, "%d", &ws->demand[j]) == 1;
+    fclose(in);
+    if (ok) *inst = (SsmInstance){ m, n, ws->cost, ws->supply, ws->demand, NULL, 0 };
+    return ok;
+}
+
+static long long instance_checksum(const SsmInstance *inst) {
+    long long s = 0;
+    size_t mn = (size_t)inst->m * (size_t)inst->n;
+    for (size_t k = 0; k < mn; k++) s += inst->cost[k] * (long long)(k % 7 + 1);
+    for (int i = 0; i < inst->m; i++) s += inst->supply[i];
+    for (int j = 0; j < inst->n; j++) s -= inst->demand[j];
+    return s;
+}
+
+static long long file_size(const char *path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? (long long)st.st_size : -1;
+}
+
+typedef bool (*InstanceLoader)(const char *, SsmWorkspace *, const SsmOptions *, SsmInstance *);
+
+/* Ulangi load sampai minimal ~0.5 detik, kembalikan MB/s (atau -1 jika gagal) */
+static double measure_parse(InstanceLoader loader, const char *path, SsmWorkspace *ws, long long *checksum) {
+    long long bytes = file_size(path);
+    int reps = 0;
+    double t0 = now_sec(), t;
+    do {
+        SsmInstance inst;
+        if (!loader(path, ws, &default_options, &inst)) return -1.0;
+        *checksum = instance_checksum(&inst); // sentuh semua data, termasuk halaman mmap
+        instance_release(&inst);
+        reps++;
+        t = now_sec() - t0;
+    } while (t < 0.5);
+    return (double)bytes * reps / t / (1024.0 * 1024.0);
+}
+
+/* Throughput parsing (MB/s): fscanf lama, parser teks cepat, dan file biner via mmap */
+static int run_parse_benchmark(const char *text_path) {
+    SsmWorkspace ws = { 0 };
+    // Salinan biner sementara di direktori yang sama (file system sama dengan file teks), dihapus setelah diukur
+    char bin_path[4096];
+    snprintf(bin_path, sizeof bin_path, "%s.bin.XXXXXX", text_path);
+    int fd = mkstemp(bin_path);
+    if (fd < 0) {
+        fprintf(stderr, "Gagal membuat file sementara %s: %s\n", bin_path, strerror(errno));
+        return 1;
+    }
+    close(fd);
+    if (convert_to_bin(text_path, bin_path) != 0) {
+        unlink(bin_path);
+        return 1;
+    }
+
+    long long ck_scanf = 0, ck_text = 0, ck_bin = 0;
+    double mb_scanf = measure_parse(load_instance_fscanf, text_path, &ws, &ck_scanf);
+    double mb_text = measure_parse(load_instance, text_path, &ws, &ck_text);
+    double mb_bin = measure_parse(load_instance, bin_path, &ws, &ck_bin);
+
+    printf("%-14s %12s %10s\n", "parser", "file_bytes", "MB/s");
+    printf("%-14s %12lld %10.1f\n", "fscanf (lama)", file_size(text_path), mb_scanf);
+    printf("%-14s %12lld %10.1f\n", "teks cepat", file_size(text_path), mb_text);
+    printf("%-14s %12lld %10.1f\n", "biner mmap", file_size(bin_path), mb_bin);
+    unlink(bin_path);
+    bool same = ck_scanf == ck_text && ck_text == ck_bin;
+    printf("Checksum data %s\n", same ? "sama untuk ketiga jalur." : "BERBEDA!");
+    ssm_workspace_free(&ws);
+    return same ? 0 : 1;
+}
+
+/* ==================== Instance sparse (CSR): rute terlarang tidak disimpan ==================== */
+
+/* Format teks sparse (file diawali token "CSR"):
+ *   CSR m n nnz
+ *   per baris i: k  j_1 c_1  ...  j_k c_k     (k arc yang diizinkan dari baris i)
+ *   supply (m), demand (n)
+ * Sel yang tidak tercantum adalah rute terlarang: tidak ada di memori dan tidak pernah discan solver. */
+#define SSM_CSR_MAGIC "CSR"
+
+typedef struct {
+    int m, n, nnz;
+    int *row_start;       // m+1, arc baris i = [row_start[i], row_start[i+1])
+    int *col, *cost;      // nnz, kolom naik per baris (tanpa duplikat)
+    int *supply, *demand; // m, n
+    int *flow;            // nnz, hasil solve
+} SsmSparse;
+
+static void sparse_free(SsmSparse *sp) {
+    free(sp->row_start); free(sp->col); free(sp->cost);
+    free(sp->supply); free(sp->demand); free(sp->flow);
+    memset(sp, 0, sizeof *sp);
+}
+
+static bool is_sparse_file(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    char head[64];
+    ssize_t got = pread(fd, head, sizeof head, 0);
+    close(fd);
+    int k = 0;
+    while (k < got && (head[k] == ' ' || head[k] == '\n' || head[k] == '\r' || head[k] == '\t')) k++;
+    return got - k > 3 && memcmp(head + k, SSM_CSR_MAGIC, 3) == 0 && (head[k + 3] == ' ' || head[k + 3] == '\t');
+}
+
+static bool load_sparse_text(const char *path, SsmSparse *sp) {
+    memset(sp, 0, sizeof *sp);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    size_t len = 0;
+    char *buf = read_whole_file(fd, &len);
+    close(fd);
+    if (buf == NULL) return false;
+    const char *p = memchr(buf, 'C', len);
+    TextCursor tc = { p != NULL ? p + 3 : buf + len, buf + len };
+    int m, n, nnz;
+    bool ok = p != NULL && text_next_int(&tc, &m) && text_next_int(&tc, &n) && text_next_int(&tc, &nnz) &&
+              m > 0 && n > 0 && nnz >= 0;
+    if (ok) {
+        sp->m = m; sp->n = n; sp->nnz = nnz;
+        sp->row_start = malloc(((size_t)m + 1) * sizeof(int));
+        sp->col = malloc(((size_t)nnz + 1) * sizeof(int));
+        sp->cost = malloc(((size_t)nnz + 1) * sizeof(int));
+        sp->flow = calloc((size_t)nnz + 1, sizeof(int));
+        sp->supply = malloc((size_t)m * sizeof(int));
+        sp->demand = malloc((size_t)n * sizeof(int));
+        ok = sp->row_start && sp->col && sp->cost && sp->flow && sp->supply && sp->demand;
+    }
+    uint64_t *keys = ok ? malloc(((size_t)n + 1) * sizeof(uint64_t)) : NULL;
+    ok = ok && keys != NULL;
+    int fill = 0;
+    for (int i = 0; ok && i < m; i++) {
+        int k;
+        sp->row_start[i] = fill;
+        ok = text_next_int(&tc, &k) && k >= 0 && k <= n && k <= nnz - fill;
+        bool sorted = true;
+        for (int a = 0; ok && a < k; a++) {
+            int j, c;
+            ok = text_next_int(&tc, &j) && text_next_int(&tc, &c) && j >= 0 && j < n;
+            if (!ok) break;
+            if (a > 0 && j <= sp->col[fill + a - 1]) sorted = false;
+            sp->col[fill + a] = j;
+            sp->cost[fill + a] = c;
+        }
+        if (ok && !sorted) {
+            // Urutkan arc baris ini per kolom; kolom ganda ditolak (satu rute = satu arc)
+            for (int a = 0; a < k; a++) keys[a] = (uint64_t)sp->col[fill + a] << 32 | (uint32_t)sp->cost[fill + a];
+            qsort(keys, (size_t)k, sizeof(uint64_t), cmp_u64);
+            for (int a = 0; a < k; a++) {
+                sp->col[fill + a] = (int)(keys[a] >> 32);
+                sp->cost[fill + a] = (int)(uint32_t)keys[a];
+                if (a > 0 && sp->col[fill + a] == sp->col[fill + a - 1]) ok = false;
+            }
+        }
+        fill += k;
+    }
+    if (ok) sp->row_start[m] = fill;
+    ok = ok && fill == nnz;
+    for (int i = 0; ok && i < m; i++) ok = text_next_int(&tc, &sp->supply[i]) && sp->supply[i] >= 0;
+    for (int j = 0; ok && j < n; j++) ok = text_next_int(&tc, &sp->demand[j]) && sp->demand[j] >= 0;
+    free(keys);
+    free(buf);
+    if (!ok) sparse_free(sp);
+    return ok;
+}
+
+/* Konversi instance padat ke CSR: sel dengan cost >= forbid dianggap rute terlarang dan dibuang */
+static int convert_to_csr(const char *in_path, const char *out_path, int forbid) {
+    SsmWorkspace ws = { 0 };
+    SsmInstance inst;
+    if (!load_instance(in_path, &ws, &default_options, &inst)) {
+        fprintf(stderr, "Gagal membaca %s\n", in_path);
+        ssm_workspace_free(&ws);
+        return 1;
+    }
+    FILE *out = fopen(out_path, "w");
+    long long nnz = 0;
+    int m = inst.m, n = inst.n;
+    for (size_t k = 0; k < (size_t)m * n; k++) nnz += inst.cost[k] < forbid;
+    bool ok = out != NULL && nnz <= INT_MAX;
+    if (ok) {
+        fprintf(out, "%s %d %d %lld\n", SSM_CSR_MAGIC, m, n, nnz);
+        for (int i = 0; i < m; i++) {
+            const int *row = inst.cost + (size_t)i * n;
+            int k = 0;
+            for (int j = 0; j < n; j++) k += row[j] < forbid;
+            fprintf(out, "%d", k);
+            for (int j = 0; j < n; j++)
+                if (row[j] < forbid) fprintf(out, " %d %d", j, row[j]);
+            fputc('\n', out);
+        }
+        for (int i = 0; i < m; i++) fprintf(out, "%d%c", inst.supply[i], i + 1 < m ? ' ' : '\n');
+        for (int j = 0; j < n; j++) fprintf(out, "%d%c", inst.demand[j], j + 1 < n ? ' ' : '\n');
+    }
+    if (out != NULL && fclose(out) != 0) ok = false;
+    if (ok) printf("%s -> %s (%dx%d, %lld arc diizinkan, %.1f%%)\n", in_path, out_path, m, n, nnz,
+                   100.0 * (double)nnz / ((double)m * n));
+    else fprintf(stderr, "Gagal menulis %s\n", out_path);
+    instance_release(&inst);
+    ssm_workspace_free(&ws);
+    return ok ? 0 : 1;
+}
+
+/* Komponen terhubung graf bipartit baris-kolom (lewat arc yang diizinkan). Komponen tidak berbagi
+ * baris, kolom maupun arc, jadi masing-masing bisa diselesaikan sendiri dan hasilnya dijumlahkan. */
+typedef struct {
+    int rows, cols, arcs;
+    int row_off, col_off;   // posisi di SparsePlan.rows / SparsePlan.cols
+    long long cost, unmet, pivots;
+} SparseComponent;
+
+typedef struct {
+    int ncomp;
+    SparseComponent *comp;
+    int *order;             // indeks komponen, terbesar dulu (dibagikan ke worker dalam urutan ini)
+    int *rows, *cols;       // baris/kolom dikelompokkan per komponen (urut indeks naik di dalam komponen)
+    int *local;             // m+n, indeks lokal baris/kolom di dalam komponennya
+    long long isolated_demand; // demand kolom tanpa arc sama sekali (tidak mungkin dilayani)
+} SparsePlan;
+
+static void sparse_plan_free(SparsePlan *pl) {
+    free(pl->comp); free(pl->order); free(pl->rows); free(pl->cols); free(pl->local);
+    memset(pl, 0, sizeof *pl);
+}
+
+/* Union-find atas node baris (0..m-1) dan kolom (m..m+n-1). Baris/kolom tanpa arc tidak membentuk
+ * komponen: baris seperti itu hanya menyisakan supply, kolom seperti itu dicatat di isolated_demand. */
+static bool sparse_split_components(const SsmSparse *sp, SparsePlan *pl) {
+    int m = sp->m, n = sp->n, N = m + n;
+    memset(pl, 0, sizeof *pl);
+    int *uf = malloc((size_t)N * sizeof(int));
+    int *cid = malloc((size_t)N * sizeof(int));
+    pl->local = malloc((size_t)N * sizeof(int));
+    pl->rows = malloc((size_t)m * sizeof(int));
+    pl->cols = malloc((size_t)n * sizeof(int));
+    bool ok = uf && cid && pl->local && pl->rows && pl->cols;
+    if (ok) {
+        for (int v = 0; v < N; v++) { uf[v] = v; cid[v] = -1; }
+        for (int i = 0; i < m; i++)
+            for (int k = sp->row_start[i]; k < sp->row_start[i + 1]; k++) {
+                int a = uf_find(uf, i), b = uf_find(uf, m + sp->col[k]);
+                if (a != b) uf[a] = b;
+            }
+        int K = 0;
+        for (int i = 0; i < m; i++)
+            if (sp->row_start[i + 1] > sp->row_start[i] && cid[uf_find(uf, i)] < 0) cid[uf_find(uf, i)] = K++;
+        pl->ncomp = K;
+        pl->comp = calloc((size_t)K + 1, sizeof(SparseComponent));
+        pl->order = malloc(((size_t)K + 1) * sizeof(int));
+        ok = pl->comp && pl->order;
+    }
+    if (ok) {
+        // Hitung ukuran, lalu kelompokkan baris/kolom per komponen (counting sort, urutan indeks terjaga)
+        for (int i = 0; i < m; i++) {
+            int c = cid[uf_find(uf, i)];
+            if (c < 0) continue;
+            pl->comp[c].rows++;
+            pl->comp[c].arcs += sp->row_start[i + 1] - sp->row_start[i];
+        }
+        for (int j = 0; j < n; j++) {
+            int c = cid[uf_find(uf, m + j)];
+            if (c >= 0) pl->comp[c].cols++;
+            else pl->isolated_demand += sp->demand[j];
+        }
+        int ro = 0, co = 0;
+        for (int c = 0; c < pl->ncomp; c++) {
+            pl->comp[c].row_off = ro; ro += pl->comp[c].rows; pl->comp[c].rows = 0;
+            pl->comp[c].col_off = co; co += pl->comp[c].cols; pl->comp[c].cols = 0;
+        }
+        for (int i = 0; i < m; i++) {
+            int c = cid[uf_find(uf, i)];
+            if (c < 0) continue;
+            pl->local[i] = pl->comp[c].rows;
+            pl->rows[pl->comp[c].row_off + pl->comp[c].rows++] = i;
+        }
+        for (int j = 0; j < n; j++) {
+            int c = cid[uf_find(uf, m + j)];
+            if (c < 0) continue;
+            pl->local[m + j] = pl->comp[c].cols;
+            pl->cols[pl->comp[c].col_off + pl->comp[c].cols++] = j;
+        }
+        // Komponen terbesar dibagikan lebih dulu supaya worker tidak menunggu satu komponen besar di akhir
+        uint64_t *keys = malloc(((size_t)pl->ncomp + 1) * sizeof(uint64_t));
+        ok = keys != NULL;
+        for (int c = 0; ok && c < pl->ncomp; c++) {
+            long long size = (long long)pl->comp[c].arcs + pl->comp[c].rows + pl->comp[c].cols;
+            keys[c] = (uint64_t)(UINT32_MAX - (size < UINT32_MAX ? size : UINT32_MAX)) << 32 | (uint32_t)c;
+        }
+        if (ok) qsort(keys, (size_t)pl->ncomp, sizeof(uint64_t), cmp_u64);
+        for (int c = 0; ok && c < pl->ncomp; c++) pl->order[c] = (int)(uint32_t)keys[c];
+        free(keys);
+    }
+    free(uf);
+    free(cid);
+    if (!ok) sparse_plan_free(pl);
+    return ok;
+}
+
+/* Workspace per worker untuk satu komponen: CSR lokal, seed dan pohon basis network simplex. Seperti
+ * SsmWorkspace, satu blok yang hanya dialokasikan ulang jika komponen berikutnya lebih besar.
+ * Node pohon: baris 0..mc-1, baris artifisial A = mc, kolom M..M+nc-1 (M = mc+1), kolom dummy D = M+nc. */
+typedef struct {
+    size_t cap;
+    unsigned char *base;
+    NsTree ns;
+    int *lstart;              // mc+1
+    int *lrow, *lcol, *lcost, *lglob, *x; // ac: baris/kolom lokal, cost, indeks arc global, flow seed
+    uint64_t *keys;           // ac, urutan least-cost
+    int *rem;                 // mc+nc, sisa supply/demand seed
+    int *uf, *er, *ec, *ef;   // N: union-find, arc pohon awal (baris, kolom, flow)
+    long long *ecost;         // N
+    int *adj_start, *adj, *queue; // N+1, 2N, N
+} SparseWorkspace;
+
+static size_t sparse_workspace_layout(SparseWorkspace *w, unsigned char *base, int mc, int nc, int ac) {
+    size_t off = 0, N = (size_t)mc + nc + 2, A = (size_t)ac;
+    ws_carve(base, &off, ((size_t)mc + 1) * sizeof(int), (void **)&w->lstart);
+    int **arc_arrays[] = { &w->lrow, &w->lcol, &w->lcost, &w->lglob, &w->x };
+    for (size_t k = 0; k < sizeof arc_arrays / sizeof arc_arrays[0]; k++)
+        ws_carve(base, &off, A * sizeof(int), (void **)arc_arrays[k]);
+    ws_carve(base, &off, A * sizeof(uint64_t), (void **)&w->keys);
+    ws_carve(base, &off, ((size_t)mc + nc) * sizeof(int), (void **)&w->rem);
+    int **node_arrays[] = { &w->uf, &w->er, &w->ec, &w->ef, &w->queue, &w->ns.parent, &w->ns.depth, &w->ns.flow,
+                            &w->ns.first_child, &w->ns.next_sib, &w->ns.prev_sib, &w->ns.thread,
+                            &w->ns.rev_thread, &w->ns.stack };
+    for (size_t k = 0; k < sizeof node_arrays / sizeof node_arrays[0]; k++)
+        ws_carve(base, &off, N * sizeof(int), (void **)node_arrays[k]);
+    ws_carve(base, &off, (N + 1) * sizeof(int), (void **)&w->adj_start);
+    ws_carve(base, &off, 2 * N * sizeof(int), (void **)&w->adj);
+    ws_carve(base, &off, N * sizeof(long long), (void **)&w->ecost);
+    ws_carve(base, &off, N * sizeof(long long), (void **)&w->ns.pi);
+    ws_carve(base, &off, N * sizeof(long long), (void **)&w->ns.arc_cost);
+    return off;
+}
+
+static bool sparse_workspace_prepare(SparseWorkspace *w, int mc, int nc, int ac) {
+    size_t need = sparse_workspace_layout(w, NULL, mc, nc, ac);
+    if (need > w->cap) {
+        free(w->base);
+        w->base = aligned_alloc(WS_ALIGN, need);
+        w->cap = w->base != NULL ? need : 0;
+        if (w->base == NULL) return false;
+    }
+    sparse_workspace_layout(w, w->base, mc, nc, ac);
+    return true;
+}
+
+/* Tambah arc ke pohon basis awal; false jika arc menutup cycle */
+static bool sparse_tree_edge(SparseWorkspace *w, int M, int *ne, int r, int c, int flow, long long cost) {
+    int a = uf_find(w->uf, r), b = uf_find(w->uf, M + c);
+    if (a == b) return false;
+    w->uf[a] = b;
+    w->er[*ne] = r; w->ec[*ne] = c; w->ef[*ne] = flow; w->ecost[*ne] = cost;
+    (*ne)++;
+    return true;
+}
+
+/* Basis awal dari seed: arc seed ber-flow positif, sisa supply ke D, demand yang belum terpenuhi dari A
+ * (biaya big_m), A -> D, lalu arc ber-flow 0 untuk menyambung sisa komponen. Setiap arc seed menghabiskan
+ * baris atau kolomnya, jadi tiap komponen seed punya paling banyak satu baris/kolom bersisa dan hasilnya
+ * pohon. Jika tetap terbentuk cycle, pemanggil mengulang dengan seed kosong (basis artifisial murni). */
+static bool sparse_build_basis(SparseWorkspace *w, int mc, int nc, int ac, long long sum_d, long long big_m) {
+    int M = mc + 1, N = M + nc + 1, ne = 0;
+    NsTree *t = &w->ns;
+    for (int v = 0; v < N; v++) w->uf[v] = v;
+    long long unmet = 0;
+    for (int j = 0; j < nc; j++) unmet += w->rem[mc + j];
+    bool ok = sparse_tree_edge(w, M, &ne, mc, nc, (int)(sum_d - unmet), 0);
+    for (int k = 0; ok && k < ac; k++)
+        if (w->x[k] > 0) ok = sparse_tree_edge(w, M, &ne, w->lrow[k], w->lcol[k], w->x[k], w->lcost[k]);
+    for (int r = 0; ok && r < mc; r++)
+        if (w->rem[r] > 0) ok = sparse_tree_edge(w, M, &ne, r, nc, w->rem[r], 0);
+    for (int j = 0; ok && j < nc; j++)
+        if (w->rem[mc + j] > 0) ok = sparse_tree_edge(w, M, &ne, mc, j, w->rem[mc + j], big_m);
+    for (int j = 0; ok && j < nc; j++)
+        if (uf_find(w->uf, M + j) != uf_find(w->uf, mc)) ok = sparse_tree_edge(w, M, &ne, mc, j, 0, big_m);
+    for (int r = 0; ok && r < mc; r++)
+        if (uf_find(w->uf, r) != uf_find(w->uf, mc)) ok = sparse_tree_edge(w, M, &ne, r, nc, 0, 0);
+    if (!ok || ne != N - 1) return false;
+
+    // Orientasikan dari root A lewat BFS atas adjacency (CSR) arc pohon
+    for (int v = 0; v <= N; v++) w->adj_start[v] = 0;
+    for (int e = 0; e < ne; e++) { w->adj_start[w->er[e] + 1]++; w->adj_start[M + w->ec[e] + 1]++; }
+    for (int v = 0; v < N; v++) w->adj_start[v + 1] += w->adj_start[v];
+    for (int e = 0; e < ne; e++) {
+        w->adj[w->adj_start[w->er[e]]++] = e;
+        w->adj[w->adj_start[M + w->ec[e]]++] = e;
+    }
+    for (int v = N; v > 0; v--) w->adj_start[v] = w->adj_start[v - 1];
+    w->adj_start[0] = 0;
+    for (int v = 0; v < N; v++) { t->parent[v] = -1; t->first_child[v] = -1; t->depth[v] = -1; }
+    int qh = 0, qt = 0;
+    w->queue[qt++] = mc; t->depth[mc] = 0;
+    while (qh < qt) {
+        int v = w->queue[qh++];
+        for (int k = w->adj_start[v]; k < w->adj_start[v + 1]; k++) {
+            int e = w->adj[k], u = v < M ? M + w->ec[e] : w->er[e];
+            if (t->depth[u] >= 0) continue;
+            t->depth[u] = 0;
+            t->parent[u] = v;
+            t->flow[u] = w->ef[e];
+            t->arc_cost[u] = w->ecost[e];
+            ns_attach_child(t, u, v);
+            w->queue[qt++] = u;
+        }
+    }
+    if (qt != N) return false;
+    int last = ns_rebuild_subtree(t, mc);
+    t->thread[last] = -1;
+    t->rev_thread[mc] = -1;
+    return true;
+}
+
+/* Block pricing atas arc yang diizinkan saja (ditambah arc ke D dan arc artifisial dari A) */
+static bool sparse_find_entering(SparseWorkspace *w, int mc, int nc, long long big_m, int *ei, int *ej,
+                                 long long *ec) {
+    NsTree *t = &w->ns;
+    int M = mc + 1;
+    const long long *pv = t->pi + M;
+    long long best = 0, scanned = 0;
+    int start = t->next_row;
+    for (int k = 0; k < M; k++) {
+        int i = start + k < M ? start + k : start + k - M;
+        long long ui = t->pi[i];
+        if (i < mc) {
+            for (int a = w->lstart[i]; a < w->lstart[i + 1]; a++) {
+                long long rc = w->lcost[a] - ui - pv[w->lcol[a]];
+                if (rc < best) { best = rc; *ei = i; *ej = w->lcol[a]; *ec = w->lcost[a]; }
+            }
+            scanned += w->lstart[i + 1] - w->lstart[i] + 1;
+        } else {
+            for (int j = 0; j < nc; j++)
+                if (big_m - ui - pv[j] < best) { best = big_m - ui - pv[j]; *ei = i; *ej = j; *ec = big_m; }
+            scanned += nc + 1;
+        }
+        if (-ui - pv[nc] < best) { best = -ui - pv[nc]; *ei = i; *ej = nc; *ec = 0; }
+        if (scanned >= t->block && best < 0) {
+            t->next_row = i + 1 < M ? i + 1 : 0;
+            return true;
+        }
+    }
+    return best < 0;
+}
+
+/* Selesaikan satu komponen secara eksak: seed least-cost atas arc komponen, lalu network simplex big-M.
+ * Flow ditulis ke sp->flow (arc komponen lain tidak disentuh, jadi aman dari banyak thread). */
+static bool sparse_solve_component(SsmSparse *sp, const SparsePlan *pl, int c, SparseWorkspace *w) {
+    SparseComponent *cp = &pl->comp[c];
+    int mc = cp->rows, nc = cp->cols, ac = cp->arcs, M = mc + 1, N = M + nc + 1;
+    if (!sparse_workspace_prepare(w, mc, nc, ac)) return false;
+
+    // CSR lokal; indeks kolom lokal naik mengikuti indeks global, jadi urutan kolom per baris tetap
+    long long max_abs = 0, sum_d = 0;
+    int fill = 0;
+    for (int r = 0; r < mc; r++) {
+        int i = pl->rows[cp->row_off + r];
+        w->lstart[r] = fill;
+        w->rem[r] = sp->supply[i];
+        for (int k = sp->row_start[i]; k < sp->row_start[i + 1]; k++, fill++) {
+            w->lrow[fill] = r;
+            w->lcol[fill] = pl->local[sp->m + sp->col[k]];
+            w->lcost[fill] = sp->cost[k];
+            w->lglob[fill] = k;
+            long long a = sp->cost[k] < 0 ? -(long long)sp->cost[k] : sp->cost[k];
+            if (a > max_abs) max_abs = a;
+        }
+    }
+    w->lstart[mc] = fill;
+    for (int j = 0; j < nc; j++) {
+        w->rem[mc + j] = sp->demand[pl->cols[cp->col_off + j]];
+        sum_d += w->rem[mc + j];
+    }
+    // Path pohon melewati A paling banyak sekali, jadi big-M > N * max|c| cukup untuk mengalahkan rute nyata mana pun
+    long long big_m = (long long)N * (max_abs + 1) + 1;
+
+    // Seed least-cost: urutkan arc sekali, alokasikan min(sisa supply, sisa demand)
+    for (int k = 0; k < ac; k++) {
+        w->x[k] = 0;
+        w->keys[k] = ((uint64_t)((uint32_t)w->lcost[k] ^ 0x80000000u) << 32) | (uint32_t)k;
+    }
+    qsort(w->keys, (size_t)ac, sizeof(uint64_t), cmp_u64);
+    for (int q = 0; q < ac; q++) {
+        int k = (int)(w->keys[q] & 0xffffffffu), r = w->lrow[k], j = mc + w->lcol[k];
+        int amt = w->rem[r] < w->rem[j] ? w->rem[r] : w->rem[j];
+        if (amt <= 0) continue;
+        w->x[k] = amt;
+        w->rem[r] -= amt;
+        w->rem[j] -= amt;
+    }
+
+    NsTree *t = &w->ns;
+    t->m = M; t->n = t->n2 = nc + 1;
+    t->next_row = 0;
+    t->block = 10;
+    while (t->block * t->block < (long long)ac + mc + nc + 1) t->block++;
+    if (!sparse_build_basis(w, mc, nc, ac, sum_d, big_m)) {
+        for (int k = 0; k < ac; k++) w->x[k] = 0;
+        for (int r = 0; r < mc; r++) w->rem[r] = sp->supply[pl->rows[cp->row_off + r]];
+        for (int j = 0; j < nc; j++) w->rem[mc + j] = sp->demand[pl->cols[cp->col_off + j]];
+        if (!sparse_build_basis(w, mc, nc, ac, sum_d, big_m)) return false;
+    }
+
+    long long pivots = 0;
+    const long long max_pivots = 1000LL * N + 100000;
+    int ei = 0, ej = 0;
+    long long ec = 0;
+    while (pivots < max_pivots && sparse_find_entering(w, mc, nc, big_m, &ei, &ej, &ec)) {
+        ns_pivot(t, M, ei, ej, ec);
+        pivots++;
+    }
+
+    // Tulis flow arc pohon yang nyata ke sp->flow; flow arc dari A = demand yang tidak bisa dilayani
+    cp->cost = 0;
+    cp->unmet = 0;
+    cp->pivots = pivots;
+    for (int v = 0; v < N; v++) {
+        int p = t->parent[v];
+        if (p < 0 || t->flow[v] == 0) continue;
+        int r = v < M ? v : p, col = v < M ? p - M : v - M;
+        if (col == nc) continue;
+        if (r == mc) { cp->unmet += t->flow[v]; continue; }
+        int lo = w->lstart[r], hi = w->lstart[r + 1] - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (w->lcol[mid] < col) lo = mid + 1; else hi = mid;
+        }
+        sp->flow[w->lglob[lo]] = t->flow[v];
+        cp->cost += (long long)t->flow[v] * w->lcost[lo];
+    }
+    return pivots < max_pivots;
+}
+
+typedef struct {
+    SsmSparse *sp;
+    const SparsePlan *plan;
+    atomic_int next, failed;
+} SparsePool;
+
+static void *sparse_worker_main(void *arg) {
+    SparsePool *p = arg;
+    SparseWorkspace w = { 0 };
+    for (int k; (k = atomic_fetch_add(&p->next, 1)) < p->plan->ncomp; )
+        if (!sparse_solve_component(p->sp, p->plan, p->plan->order[k], &w)) atomic_fetch_add(&p->failed, 1);
+    free(w.base);
+    return NULL;
+}
+
+/* Tulis s sebagai string JSON (dengan tanda kutip): ", \ dan karakter kontrol di-escape */
+static void json_write_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (const unsigned char *c = (const unsigned char *)s; *c; c++) {
+        if (*c == '"' || *c == '\\') fprintf(out, "\\%c", *c);
+        else if (*c < 0x20) fprintf(out, "\\u%04x", *c);
+        else fputc(*c, out);
+    }
+    fputc('"', out);
+}
+
+/* Solver CSR selalu least-cost + network simplex sampai optimal per komponen: opsi pipeline padat (seed, fase
+ * rectangle, feasibility SSM, batas waktu/kerja, trace, portfolio) tidak dipakai. Sebutkan yang diberi user supaya
+ * tidak dikira berlaku; --exact tidak disebut karena hasil CSR memang sudah optimal. */
+static void sparse_warn_ignored(const SsmOptions *opt, bool tracing, int portfolio) {
+    const SsmOptions *d = &default_options;
+    const char *names[12];
+    int k = 0;
+    if (opt->seed != d->seed) names[k++] = "--seed";
+    if (opt->rect_mode != d->rect_mode) names[k++] = "--rect";
+    if (opt->pivot != d->pivot || opt->pivot_k != d->pivot_k || opt->pivot_block != d->pivot_block) names[k++] = "--improve";
+    if (opt->feas_scan != d->feas_scan) names[k++] = "--feas-scan";
+    if (opt->flc_rule != d->flc_rule) names[k++] = "--flc";
+    if (opt->tie_seed != d->tie_seed) names[k++] = "--tie-seed";
+    if (opt->time_limit_ms > 0) names[k++] = "--time-limit";
+    if (opt->work_budget > 0) names[k++] = "--work-budget";
+    if (tracing) names[k++] = "--trace";
+    if (portfolio != 0) names[k++] = "--portfolio";
+    if (k == 0) return;
+    printf("Peringatan: instance CSR selalu diselesaikan dengan least-cost + network simplex; opsi diabaikan:");
+    for (int i = 0; i < k; i++) printf(" %s", names[i]);
+    printf("\n");
+}
+
+/* Muat instance CSR, pecah per komponen, selesaikan komponen secara paralel lalu gabungkan hasilnya */
+static int run_sparse_file(const char *path, int nworkers) {
+    SsmSparse sp;
+    if (!load_sparse_text(path, &sp)) {
+        printf("Gagal membaca instance sparse %s, file dilewati.\n", path);
+        return 1;
+    }
+    uint64_t t0 = now_ns();
+    SparsePlan pl;
+    if (!sparse_split_components(&sp, &pl)) {
+        printf("Memori tidak cukup untuk memecah komponen %s\n", path);
+        sparse_free(&sp);
+        return 1;
+    }
+    uint64_t t1 = now_ns();
+    if (nworkers > pl.ncomp) nworkers = pl.ncomp;
+    if (nworkers < 1) nworkers = 1;
+
+    SparsePool pool = { .sp = &sp, .plan = &pl };
+    atomic_init(&pool.next, 0);
+    atomic_init(&pool.failed, 0);
+    pthread_t *tids = malloc((size_t)nworkers * sizeof(pthread_t));
+    int started = 0;
+    for (int w = 1; tids != NULL && w < nworkers; w++) {
+        if (pthread_create(&tids[w], NULL, sparse_worker_main, &pool) != 0) break;
+        started++;
+    }
+    sparse_worker_main(&pool); // thread utama ikut mengerjakan komponen
+    for (int w = 1; w <= started; w++) pthread_join(tids[w], NULL);
+    free(tids);
+    uint64_t t2 = now_ns();
+
+    // Gabungkan dalam urutan indeks komponen supaya hasil tidak bergantung pada penjadwalan thread
+    long long tot = 0, unmet = pl.isolated_demand, pivots = 0;
+    int largest = pl.ncomp > 0 ? pl.order[0] : -1;
+    for (int c = 0; c < pl.ncomp; c++) {
+        tot += pl.comp[c].cost;
+        unmet += pl.comp[c].unmet;
+        pivots += pl.comp[c].pivots;
+    }
+
+    if (LOG_STEPS) {
+        printf("\n--- INPUT SUMMARY (SPARSE) ---\n");
+        printf("Dimensions : rows (m) = %d, cols (n) = %d, arc diizinkan = %d (%.2f%%)\n", sp.m, sp.n, sp.nnz,
+               100.0 * sp.nnz / ((double)sp.m * sp.n));
+        printf("Komponen terhubung : %d, worker : %d\n", pl.ncomp, started + 1);
+        for (int k = 0; k < pl.ncomp && k < 20; k++) {
+            const SparseComponent *cp = &pl.comp[pl.order[k]];
+            printf("  komponen %d: %d baris x %d kolom, %d arc, pivot %lld, cost %lld%s\n", pl.order[k], cp->rows,
+                   cp->cols, cp->arcs, cp->pivots, cp->cost, cp->unmet > 0 ? " (TIDAK FEASIBLE)" : "");
+        }
+        if (pl.ncomp > 20) printf("  ... %d komponen lain\n", pl.ncomp - 20);
+        printf("\n=== ALOKASI (arc dengan flow > 0) ===\n");
+        for (int i = 0; i < sp.m; i++)
+            for (int k = sp.row_start[i]; k < sp.row_start[i + 1]; k++)
+                if (sp.flow[k] > 0) printf("  x[%d][%d] = %d (cost %d)\n", i, sp.col[k], sp.flow[k], sp.cost[k]);
+    }
+    printf("\n>>> Total Transportation Cost (final) : %lld\n", tot);
+    if (unmet > 0)
+        printf(">>> Status: TIDAK FEASIBLE (%lld unit demand tidak bisa dilayani lewat rute yang diizinkan)\n", unmet);
+    if (atomic_load(&pool.failed) > 0)
+        printf("Peringatan: %d komponen gagal diselesaikan (memori atau batas pivot).\n", atomic_load(&pool.failed));
+    fputs("{\"file\":", stdout);
+    json_write_string(stdout, path);
+    printf(",\"m\":%d,\"n\":%d,\"nnz\":%d,\"components\":%d,\"largest_arcs\":%d,\"workers\":%d,"
+           "\"ns_pivots\":%lld,\"split_ns\":%llu,\"solve_ns\":%llu,\"final_cost\":%lld,\"unmet_demand\":%lld}\n",
+           sp.m, sp.n, sp.nnz, pl.ncomp, largest >= 0 ? pl.comp[largest].arcs : 0, started + 1, pivots,
+           (unsigned long long)(t1 - t0), (unsigned long long)(t2 - t1), tot, unmet);
+    int rc = atomic_load(&pool.failed) == 0 ? 0 : 1;
+    sparse_plan_free(&pl);
+    sparse_free(&sp);
+    return rc;
+}
+
+/* Gap setelah satu fase: cost alokasi saat ini dikurangi bound dual terbaik sejauh ini */
+static void record_phase_gap(int m, int n, int cost[m][n], int supply[m], int demand[n], int alloc[m][n],
+                             long long cur_cost, TracePhase phase, SsmWorkspace *ws) {
+    SsmMetrics *mt = &ws->metrics;
+    if (phase != PHASE_RECT || !mt->gap_closed) {
+        cells_build(&ws->cells, m, n, alloc);
+        update_lower_bound(m, n, cost, supply, demand, alloc, cur_cost, ws);
+    }
+    if (!mt->has_bound) return;
+    mt->phase_gap[phase] = cur_cost - mt->lower_bound;
+    if (LOG_STEPS) printf("\n[bound] setelah fase %s: cost = %lld, lower bound dual = %lld, gap = %lld\n",
+                        trace_phase_names[phase], cur_cost, mt->lower_bound, mt->phase_gap[phase]);
+}
+
+/* Awal satu solve: metrik, bound dual terbaik dan gap per fase dikosongkan. Wajib dipanggil per instance sebelum
+ * build_initial_solution/improve_with_rectangles, karena bound instance sebelumnya bisa melebihi cost instance
+ * berikutnya dan menghentikan fase rectangle dengan klaim optimal yang salah. */
+static void ssm_solve_begin(SsmWorkspace *ws) {
+    SsmMetrics *mt = &ws->metrics;
+    memset(mt, 0, sizeof *mt);
+    for (int p = 0; p < 3; p++) mt->phase_gap[p] = -1;
+}
+
+/* Jalankan pipeline SSM untuk instance yang sudah dimuat, kembalikan total biaya akhir */
+static long long solve_instance(const SsmInstance *inst, SsmWorkspace *ws, const SsmOptions *opt) {
+    int m = inst->m, n = inst->n;
+    int (*cost)[n] = (int (*)[n])inst->cost;
+    int (*alloc)[n] = (int (*)[n])ws->alloc;
+    int *supply = inst->supply, *demand = inst->demand;
+
+    if (LOG_STEPS) {
+        printf("\n--- INPUT SUMMARY ---\n");
+        printf("Dimensions : rows (m) = %d, cols (n) = %d\n", m, n);
+        print_array_int("Supply", m, supply);
+        print_array_int("Demand", n, demand);
+        print_cost_matrix(m, n, cost, demand, supply);
+        printf("----------------------\n\n");
+    }
+
+    SsmMetrics *mt = &ws->metrics;
+    ssm_solve_begin(ws);
+    deadline_arm(&ws->deadline, opt->time_limit_ms, opt->work_budget);
+    TRACE(ws->trace, TR_INSTANCE, m, n);
+
+    TRACE(ws->trace, TR_PHASE_BEGIN, PHASE_SEED);
+    uint64_t t0 = now_ns();
+    build_initial_solution(m, n, cost, supply, demand, alloc, opt, ws);
+    uint64_t t1 = now_ns();
+    mt->seed_ns = t1 - t0;
+    mt->seed_cost = total_biaya(m, n, cost, alloc);
+    record_phase_gap(m, n, cost, supply, demand, alloc, mt->seed_cost, PHASE_SEED, ws);
+    TRACE(ws->trace, TR_PHASE_END, PHASE_SEED, (int32_t)mt->seed_cost, (int32_t)(mt->seed_cost >> 32));
+
+    TRACE(ws->trace, TR_PHASE_BEGIN, PHASE_RECT);
+    improve_with_rectangles(m, n, cost, supply, demand, alloc, opt, ws);
+    uint64_t t2 = now_ns();
+    mt->rect_ns = t2 - t1;
+    mt->final_cost = total_biaya(m, n, cost, alloc);
+    record_phase_gap(m, n, cost, supply, demand, alloc, mt->final_cost, PHASE_RECT, ws);
+    TRACE(ws->trace, TR_PHASE_END, PHASE_RECT, (int32_t)mt->final_cost, (int32_t)(mt->final_cost >> 32));
+
+    // Fase eksak tidak perlu jika gap sudah tertutup
+    if (opt->exact && !ws->deadline.expired && mt->phase_gap[PHASE_RECT] != 0) {
+        if (LOG_STEPS) printf("\n>>> Total cost setelah SSM + rectangle : %lld\n", mt->final_cost);
+        TRACE(ws->trace, TR_PHASE_BEGIN, PHASE_EXACT);
+        solve_exact_network_simplex(m, n, cost, supply, demand, alloc, ws);
+        mt->exact_ns = now_ns() - t2;
+        mt->final_cost = total_biaya(m, n, cost, alloc);
+        record_phase_gap(m, n, cost, supply, demand, alloc, mt->final_cost, PHASE_EXACT, ws);
+        TRACE(ws->trace, TR_PHASE_END, PHASE_EXACT, (int32_t)mt->final_cost, (int32_t)(mt->final_cost >> 32));
+    }
+    return mt->final_cost;
+}
+
+/* Satu baris JSON metrik per instance */
+static void print_metrics_json(FILE *out, const char *file, const SsmInstance *inst, const SsmOptions *opt,
+                               const SsmMetrics *mt) {
+    char lb[24] = "null", gap[24] = "null";
+    if (mt->has_bound) {
+        snprintf(lb, sizeof lb, "%lld", mt->lower_bound);
+        snprintf(gap, sizeof gap, "%lld", mt->final_cost - mt->lower_bound);
+    }
+    fputs("{\"file\":", out);
+    json_write_string(out, file);
+    fprintf(out, ",\"m\":%d,\"n\":%d,\"seed\":\"%s\",\"rect\":\"%s\","
+           "\"feas_iters\":%lld,\"rect_evaluated\":%lld,\"rect_moves\":%lld,\"theta_moved\":%lld,\"ns_pivots\":%lld,"
+           "\"seed_ns\":%llu,\"rect_ns\":%llu,\"exact_ns\":%llu,\"seed_cost\":%lld,\"final_cost\":%lld,"
+           "\"lower_bound\":%s,\"gap\":%s,\"phase_gap\":[%lld,%lld,%lld],\"early_stop\":%s%s%s%s}\n",
+           inst->m, inst->n, seed_strategies[opt->seed].name, rect_mode_names[opt->rect_mode],
+           mt->feas_iters, mt->rect_evaluated, mt->rect_moves, mt->theta_moved, mt->ns_pivots,
+           (unsigned long long)mt->seed_ns, (unsigned long long)mt->rect_ns, (unsigned long long)mt->exact_ns,
+           mt->seed_cost, mt->final_cost, lb, gap, mt->phase_gap[PHASE_SEED], mt->phase_gap[PHASE_RECT],
+           mt->phase_gap[PHASE_EXACT], mt->early_stop ? "true" : "false",
+           mt->early_stop ? ",\"stop_phase\":\"" : "", mt->early_stop ? trace_phase_names[mt->stop_phase] : "",
+           mt->early_stop ? "\"" : "");
+}
+
+static void print_early_stop(FILE *out, const SsmMetrics *mt) {
+    if (mt->has_bound)
+        fprintf(out, ">>> Lower bound (dual) : %lld, gap = %lld\n", mt->lower_bound, mt->final_cost - mt->lower_bound);
+    if (mt->early_stop)
+        fprintf(out, ">>> Dihentikan lebih awal (batas waktu/kerja, fase %s): alokasi feasible terbaik sejauh ini\n",
+                trace_phase_names[mt->stop_phase]);
+}
+
+/* Benchmark skala: waktu solve dan peak RSS untuk instance acak 10x10 sampai max_size x max_size */
+static int run_scaling_benchmark(int max_size, const SsmOptions *opt) {
+    static const int sizes[] = { 10, 20, 50, 100, 200, 500, 1000, 2000, 3000, 5000 };
+    SsmWorkspace ws = { 0 };
+
+    if (LOG_STEPS) printf("Catatan: jalankan dengan --quiet (atau compile dengan -DVERBOSE=0) agar log tidak ikut terukur.\n");
+    printf("%6s %6s %10s %10s %10s %14s %12s %12s\n",
+           "m", "n", "feas_s", "rect_s", "total_s", "cost", "ws_mb", "peak_rss_mb");
+    for (size_t k = 0; k < sizeof sizes / sizeof sizes[0] && sizes[k] <= max_size; k++) {
+        int m = sizes[k], n = sizes[k];
+        if (!ssm_workspace_prepare(&ws, m, n, opt, true)) {
+            printf("%6d %6d  gagal alokasi workspace\n", m, n);
+            break;
+        }
+        int (*cost)[n] = (int (*)[n])ws.cost;
+        int (*alloc)[n] = (int (*)[n])ws.alloc;
+        generate_instance(GEN_UNIFORM, m, n, cost, ws.supply, ws.demand, 12345u + (uint64_t)k);
+        ssm_solve_begin(&ws);
+        deadline_arm(&ws.deadline, opt->time_limit_ms, opt->work_budget);
+
+        double t0 = now_sec();
+        build_initial_solution(m, n, cost, ws.supply, ws.demand, alloc, opt, &ws);
+        double t1 = now_sec();
+        improve_with_rectangles(m, n, cost, ws.supply, ws.demand, alloc, opt, &ws);
+        double t2 = now_sec();
+
+        printf("%6d %6d %10.3f %10.3f %10.3f %14lld %12.1f %12.1f\n", m, n, t1 - t0, t2 - t1, t2 - t0,
+               total_biaya(m, n, cost, alloc), (double)ws.cap / (1024.0 * 1024.0), (double)peak_rss_kb() / 1024.0);
+        fflush(stdout);
+    }
+    ssm_workspace_free(&ws);
+    return 0;
+}
+
+/* Laporan per strategi seed atas testcase/nXX.txt: cost seed, iterasi rectangle, waktu, dan cost akhir */
+static int run_seed_benchmark(const SsmOptions *base_opt) {
+    size_t ns = sizeof seed_strategies / sizeof seed_strategies[0];
+    int mismatches = 0;
+    if (LOG_STEPS) printf("Catatan: jalankan dengan --quiet (atau compile dengan -DVERBOSE=0) agar log tidak ikut terukur.\n");
+    printf("%-11s %-5s %12s %6s %10s %10s %12s %8s\n",
+           "strategi", "file", "seed_cost", "iter", "seed_ms", "rect_ms", "final_cost", "status");
+    for (size_t s = 0; s < ns; s++) {
+        SsmOptions opt = *base_opt;
+        opt.seed = seed_strategies[s].id;
+        opt.exact = false;
+        SsmWorkspace ws = { 0 };
+        long long sum_seed = 0, sum_final = 0, sum_iter = 0;
+        double sum_seed_t = 0.0, sum_rect_t = 0.0;
+        int files = 0, optimal = 0;
+        for (int k = 1; k <= 35; k++) {
+            char filename[20];
+            sprintf(filename, "testcase/n%02d.txt", k);
+            SsmInstance inst;
+            if (access(filename, R_OK) != 0 || !load_instance(filename, &ws, &opt, &inst)) continue;
+            int m = inst.m, n = inst.n;
+            int (*cost)[n] = (int (*)[n])inst.cost;
+            int (*alloc)[n] = (int (*)[n])ws.alloc;
+            ssm_solve_begin(&ws);
+            deadline_arm(&ws.deadline, opt.time_limit_ms, opt.work_budget);
+
+            double t0 = now_sec();
+            build_initial_solution(m, n, cost, inst.supply, inst.demand, alloc, &opt, &ws);
+            double t1 = now_sec();
+            long long seed_cost = total_biaya(m, n, cost, alloc);
+            int iter = improve_with_rectangles(m, n, cost, inst.supply, inst.demand, alloc, &opt, &ws);
+            double t2 = now_sec();
+            long long final_cost = total_biaya(m, n, cost, alloc);
+            // Jalur langsung di atas harus sama dengan solve_instance (tanpa --exact): state antar instance bocor jika beda.
+            // Dengan --time-limit titik berhentinya tidak deterministik, jadi cross-check dilewati (--work-budget tetap dicek)
+            bool same = true;
+            if (opt.time_limit_ms <= 0) {
+                bool saved_log = log_steps;
+                log_steps = false;
+                same = final_cost == solve_instance(&inst, &ws, &opt);
+                log_steps = saved_log;
+            }
+            instance_release(&inst);
+            mismatches += !same;
+
+            const char *status = !same ? "BEDA" : optimal_solution[k] == -1 ? "-" : final_cost == optimal_solution[k] ? "OPT" : "BELUM";
+            printf("%-11s N%02d   %12lld %6d %10.3f %10.3f %12lld %8s\n", seed_strategies[s].name, k,
+                   seed_cost, iter, (t1 - t0) * 1e3, (t2 - t1) * 1e3, final_cost, status);
+            files++;
+            optimal += optimal_solution[k] != -1 && final_cost == optimal_solution[k];
+            sum_seed += seed_cost; sum_final += final_cost; sum_iter += iter;
+            sum_seed_t += t1 - t0; sum_rect_t += t2 - t1;
+        }
+        printf("%-11s TOTAL %12lld %6lld %10.3f %10.3f %12lld %5d/%-2d\n\n", seed_strategies[s].name,
+               sum_seed, sum_iter, sum_seed_t * 1e3, sum_rect_t * 1e3, sum_final, optimal, files);
+        ssm_workspace_free(&ws);
+    }
+    if (mismatches) {
+        fprintf(stderr, "Error: %d hasil benchmark seed beda dengan solve_instance\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
+
+/* Perbandingan aturan pivot fase rectangle: iterasi (move), pasangan-kolom yang dievaluasi, waktu fase rectangle
+ * dan cost akhir. Testcase dijumlahkan per aturan; instance bangkitan (uniform/clustered/geometric, 100 dan
+ * size) dilaporkan satu per satu. Semua aturan memakai seed dan opsi lain yang sama. */
+static int run_pivot_benchmark(int size, const SsmOptions *base_opt) {
+    int nr = (int)(sizeof pivot_rule_names / sizeof pivot_rule_names[0]);
+    int sizes[] = { 100, size };
+    int nsizes = size > 100 ? 2 : 1;
+    static const GenType gens[] = { GEN_UNIFORM, GEN_CLUSTERED, GEN_GEOMETRIC };
+    if (LOG_STEPS) printf("Catatan: jalankan dengan --quiet (atau compile dengan -DVERBOSE=0) agar log tidak ikut terukur.\n");
+    printf("%-6s %-20s %8s %16s %10s %14s %7s\n", "aturan", "instance", "iter", "dievaluasi", "rect_ms", "final_cost", "status");
+    for (int r = 0; r < nr; r++) {
+        SsmOptions opt = *base_opt;
+        opt.pivot = (RectPivotRule)r;
+        opt.threads = 1;
+        SsmWorkspace ws = { 0 };
+        long long sum_iter = 0, sum_eval = 0, sum_cost = 0;
+        uint64_t sum_ns = 0;
+        int files = 0, optimal = 0;
+        for (int k = 1; k <= 35; k++) {
+            char filename[20];
+            sprintf(filename, "testcase/n%02d.txt", k);
+            SsmInstance inst;
+            if (access(filename, R_OK) != 0 || !load_instance(filename, &ws, &opt, &inst)) continue;
+            long long c = solve_instance(&inst, &ws, &opt);
+            instance_release(&inst);
+            sum_iter += ws.metrics.rect_moves; sum_eval += ws.metrics.rect_evaluated;
+            sum_ns += ws.metrics.rect_ns; sum_cost += c;
+            files++;
+            optimal += optimal_solution[k] != -1 && c == optimal_solution[k];
+        }
+        char st[24];
+        snprintf(st, sizeof st, "%d/%d", optimal, files);
+        printf("%-6s %-20s %8lld %16lld %10.3f %14lld %7s\n", pivot_rule_names[r], "testcase (total)",
+               sum_iter, sum_eval, sum_ns / 1e6, sum_cost, st);
+        ssm_workspace_free(&ws);
+    }
+    printf("\n");
+    for (int g = 0; g < (int)(sizeof gens / sizeof gens[0]); g++)
+        for (int z = 0; z < nsizes; z++) {
+            int m = sizes[z], n = sizes[z];
+            long long best_cost = -1;
+            for (int r = 0; r < nr; r++) {
+                SsmOptions opt = *base_opt;
+                opt.pivot = (RectPivotRule)r;
+                opt.threads = 1;
+                SsmWorkspace ws = { 0 };
+                if (!ssm_workspace_prepare(&ws, m, n, &opt, true)) {
+                    printf("%-6s %dx%d gagal alokasi workspace\n", pivot_rule_names[r], m, n);
+                    continue;
+                }
+                generate_instance(gens[g], m, n, (int (*)[n])ws.cost, ws.supply, ws.demand, 4242u + (uint64_t)m);
+                SsmInstance inst = { m, n, ws.cost, ws.supply, ws.demand, NULL, 0 };
+                long long c = solve_instance(&inst, &ws, &opt);
+                if (best_cost < 0) best_cost = c; // aturan pertama (best) sebagai pembanding
+                char name[48], st[16];
+                snprintf(name, sizeof name, "%s %dx%d", gen_type_names[gens[g]], m, n);
+                snprintf(st, sizeof st, "%+.2f%%", best_cost > 0 ? 100.0 * (double)(c - best_cost) / (double)best_cost : 0.0);
+                printf("%-6s %-20s %8lld %16lld %10.3f %14lld %7s\n", pivot_rule_names[r], name, ws.metrics.rect_moves,
+                       ws.metrics.rect_evaluated, ws.metrics.rect_ns / 1e6, c, st);
+                fflush(stdout);
+                ssm_workspace_free(&ws);
+            }
+        }
+    return 0;
+}
+
+/* Microbenchmark kernel argmin: kolom sepanjang m baris, dibandingkan dengan scan skalar ber-stride n pada
+ * cost row-major (pola akses lama). Hasil semua kernel dicek identik dengan referensi skalar. */
+static int run_kernel_benchmark(int m) {
+    if (m < 1) m = 1;
+    int n = (int)((16u << 20) / (unsigned)m);
+    if (n < 1) n = 1;
+    size_t mn = (size_t)m * (size_t)n;
+    int *rowmaj = malloc(mn * sizeof(int)), *colmaj = malloc(mn * sizeof(int));
+    int *arr = malloc((size_t)m * sizeof(int)), *sat = malloc((size_t)m * sizeof(int));
+    int *ref = malloc(2 * (size_t)n * sizeof(int));
+    if (!rowmaj || !colmaj || !arr || !sat || !ref) {
+        printf("Gagal alokasi memori benchmark kernel.\n");
+        free(rowmaj); free(colmaj); free(arr); free(sat); free(ref);
+        return 1;
+    }
+    uint64_t seed = 777;
+    for (size_t k = 0; k < mn; k++) rowmaj[k] = rng_range(&seed, 1, 1000);
+    for (int i = 0; i < m; i++) {
+        int r = rng_range(&seed, 0, 3); // ~50% baris eligible
+        arr[i] = r == 0; sat[i] = r == 1;
+    }
+    cost_transpose(m, n, (int (*)[n])rowmaj, colmaj);
+
+    const int reps = 5;
+    double t0 = now_sec();
+    for (int r = 0; r < reps; r++)
+        for (int j = 0; j < n; j++) {
+            int best = 0;
+            for (int i = 1; i < m; i++) if (rowmaj[(size_t)best * n + j] > rowmaj[(size_t)i * n + j]) best = i;
+            ref[j] = best;
+        }
+    double t_plain = (now_sec() - t0) / reps;
+    t0 = now_sec();
+    for (int r = 0; r < reps; r++)
+        for (int j = 0; j < n; j++) {
+            int best = -1, bv = INT_MAX;
+            for (int i = 0; i < m; i++)
+                if (!arr[i] && !sat[i] && rowmaj[(size_t)i * n + j] < bv) { bv = rowmaj[(size_t)i * n + j]; best = i; }
+            ref[n + j] = best;
+        }
+    double t_mask = (now_sec() - t0) / reps;
+
+    const ArgminKernels *kernels[3] = { &argmin_kernels_scalar };
+    int nk = 1;
+#ifdef SSM_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.1")) kernels[nk++] = &argmin_kernels_sse41;
+    if (__builtin_cpu_supports("avx2")) kernels[nk++] = &argmin_kernels_avx2;
+#endif
+    printf("Kernel argmin: %d baris x %d kolom, %d ulangan (dipakai: %s)\n", m, n, reps, argmin_kernels_detect()->name);
+    printf("%-16s %12s %10s %12s %10s\n", "kernel", "argmin_Mc/s", "speedup", "masked_Mc/s", "speedup");
+    double mc = (double)mn / 1e6;
+    printf("%-16s %12.1f %10.2f %12.1f %10.2f\n", "strided-scalar", mc / t_plain, 1.0, mc / t_mask, 1.0);
+    int rc = 0;
+    for (int k = 0; k < nk; k++) {
+        const ArgminKernels *kr = kernels[k];
+        bool ok = true;
+        t0 = now_sec();
+        for (int r = 0; r < reps; r++)
+            for (int j = 0; j < n; j++)
+                if (kr->argmin(colmaj + (size_t)j * m, m) != ref[j]) ok = false;
+        double tp = (now_sec() - t0) / reps;
+        t0 = now_sec();
+        for (int r = 0; r < reps; r++)
+            for (int j = 0; j < n; j++)
+                if (kr->argmin_masked(colmaj + (size_t)j * m, arr, sat, m) != ref[n + j]) ok = false;
+        double tm = (now_sec() - t0) / reps;
+        printf("%-16s %12.1f %10.2f %12.1f %10.2f%s\n", kr->name, mc / tp, t_plain / tp, mc / tm, t_mask / tm,
+               ok ? "" : "  HASIL BERBEDA!");
+        if (!ok) rc = 1;
+    }
+    free(rowmaj); free(colmaj); free(arr); free(sat); free(ref);
+    return rc;
+}
+
+// Cek alokasi feasible dan cell list sinkron dengan alloc (hanya untuk benchmark, O(mn))
+static bool warm_state_valid(int m, int n, int supply[m], int demand[n], int alloc[m][n],
+                             const CellLists *cl) {
+    int listed = 0, positive = 0;
+    for (int i = 0; i < m; i++) {
+        long long row = 0;
+        for (int j = 0; j < n; j++) { row += alloc[i][j]; positive += alloc[i][j] > 0; if (alloc[i][j] < 0) return false; }
+        if (row > supply[i]) return false;
+        for (int k = cl->row_head[i]; k >= 0; k = cl->nodes[k].rnext, listed++)
+            if (cl->nodes[k].r != i || alloc[i][cl->nodes[k].c] <= 0) return false;
+    }
+    for (int j = 0; j < n; j++) {
+        long long col = 0;
+        for (int i = 0; i < m; i++) col += alloc[i][j];
+        if (col != demand[j]) return false;
+    }
+    return listed == positive;
+}
+
+/* Benchmark warm start: instance uniform size x size diselesaikan sekali, lalu tiap ronde menerima K perubahan
+ * acak (cost satu sel, atau pasangan supply[i]/demand[j] yang naik-turun bersama agar tetap seimbang).
+ * Re-solve warm dibandingkan dengan solve penuh dari nol atas data yang sama di workspace kedua. */
+static int run_warm_benchmark(int size, const SsmOptions *opt) {
+    static const int batch_sizes[] = { 1, 4, 16, 64 };
+    const int rounds = 5;
+    int m = size < 2 ? 2 : size, n = m;
+    SsmWorkspace ws = { 0 }, cold = { 0 };
+    if (!ssm_workspace_prepare(&ws, m, n, opt, true) || !ssm_workspace_prepare(&cold, m, n, opt, true)) {
+        fprintf(stderr, "Gagal alokasi workspace %dx%d\n", m, n);
+        ssm_workspace_free(&ws);
+        ssm_workspace_free(&cold);
+        return 1;
+    }
+    int (*cost)[n] = (int (*)[n])ws.cost;
+    int (*alloc)[n] = (int (*)[n])ws.alloc;
+    generate_instance(GEN_UNIFORM, m, n, cost, ws.supply, ws.demand, 777u);
+    SsmInstance inst = { m, n, ws.cost, ws.supply, ws.demand, NULL, 0 };
+    SsmInstance cold_inst = { m, n, cold.cost, cold.supply, cold.demand, NULL, 0 };
+    size_t mn = (size_t)m * (size_t)n;
+
+    if (LOG_STEPS) printf("Catatan: jalankan dengan --quiet (atau compile dengan -DVERBOSE=0) agar log tidak ikut terukur.\n");
+    double t0 = now_sec();
+    solve_instance(&inst, &ws, opt);
+    printf("instance %dx%d, solve awal %.3f ms, cost %lld\n", m, n, (now_sec() - t0) * 1e3, ws.metrics.final_cost);
+    printf("%5s %6s %12s %12s %9s %14s %14s %7s\n", "K", "ronde", "warm_ms", "cold_ms", "speedup",
+           "warm_cost", "cold_cost", "status");
+
+    SsmChange changes[64];
+    uint64_t s = 4242u;
+    int failures = 0;
+    for (size_t b = 0; b < sizeof batch_sizes / sizeof batch_sizes[0]; b++) {
+        int K = batch_sizes[b];
+        double sum_warm = 0.0, sum_cold = 0.0;
+        for (int r = 0; r < rounds; r++) {
+            int nch = 0;
+            while (nch < K) {
+                int i = rng_range(&s, 0, m - 1), j = rng_range(&s, 0, n - 1);
+                if (nch + 2 > K || rng_next(&s) % 2 == 0) {
+                    changes[nch++] = (SsmChange){ CHANGE_COST, i, j, rng_range(&s, 1, 1000) };
+                } else {
+                    // Pasangan seimbang: supply[i] dan demand[j] bergeser dengan delta yang sama
+                    // (nilai terakhir dalam batch yang sama menimpa nilai lama)
+                    int sup = ws.supply[i], dem = ws.demand[j], d = rng_range(&s, -20, 20);
+                    for (int c = 0; c < nch; c++) {
+                        if (changes[c].kind == CHANGE_SUPPLY && changes[c].i == i) sup = changes[c].value;
+                        if (changes[c].kind == CHANGE_DEMAND && changes[c].j == j) dem = changes[c].value;
+                    }
+                    if (sup + d < 0) d = -sup;
+                    if (dem + d < 0) d = -dem;
+                    changes[nch++] = (SsmChange){ CHANGE_SUPPLY, i, -1, sup + d };
+                    changes[nch++] = (SsmChange){ CHANGE_DEMAND, -1, j, dem + d };
+                }
+            }
+            double w0 = now_sec();
+            bool ok = ssm_resolve_warm(m, n, cost, ws.supply, ws.demand, alloc, changes, nch, opt, &ws);
+            double w1 = now_sec();
+            long long warm_cost = ws.metrics.final_cost;
+
+            memcpy(cold.cost, ws.cost, mn * sizeof(int));
+            memcpy(cold.supply, ws.supply, (size_t)m * sizeof(int));
+            memcpy(cold.demand, ws.demand, (size_t)n * sizeof(int));
+            double c0 = now_sec();
+            long long cold_cost = solve_instance(&cold_inst, &cold, opt);
+            double c1 = now_sec();
+
+            bool valid = ok && warm_state_valid(m, n, ws.supply, ws.demand, alloc, &ws.cells) &&
+                         warm_cost == total_biaya(m, n, cost, alloc);
+            const char *status = !valid ? "GAGAL" : warm_cost == cold_cost ? "SAMA"
+                                 : opt->exact ? "GAGAL" : warm_cost < cold_cost ? "LEBIH" : "KURANG";
+            failures += status[0] == 'G';
+            printf("%5d %6d %12.3f %12.3f %8.1fx %14lld %14lld %7s\n", K, r + 1, (w1 - w0) * 1e3, (c1 - c0) * 1e3,
+                   (c1 - c0) / (w1 - w0 > 1e-9 ? w1 - w0 : 1e-9), warm_cost, cold_cost, status);
+            sum_warm += w1 - w0; sum_cold += c1 - c0;
+            if (!ok) break;
+        }
+        printf("%5d %6s %12.3f %12.3f %8.1fx\n", K, "rata2", sum_warm / rounds * 1e3, sum_cold / rounds * 1e3,
+               sum_cold / (sum_warm > 1e-9 ? sum_warm : 1e-9));
+        fflush(stdout);
+    }
+    ssm_workspace_free(&ws);
+    ssm_workspace_free(&cold);
+    return failures == 0 ? 0 : 1;
+}
+
+/* ==================== Multi-skenario: satu matriks cost, banyak pasangan supply/demand ==================== */
+
+#define PAIR_DIFF_DEFAULT_MB 0 // vektor selisih pasangan baris: m^2 n / 2 int, default mati (lihat README)
+
+// Mode rectangle yang memakai kernel per pasangan baris (rect_pair_best), jadi bisa memakai pair_diff
+static bool rect_uses_pair_kernel(const SsmOptions *opt) {
+    return opt->rect_mode == RECT_SEARCH_SCAN || opt->rect_mode == RECT_SEARCH_VERIFY ||
+           opt->rect_mode == RECT_SEARCH_INCREMENTAL;
+}
+
+static size_t cost_shared_layout(SsmCostShared *sh, unsigned char *base, int m, int n, const SsmOptions *opt,
+                                 size_t diff_cap, CostOrder *scratch) {
+    size_t off = 0, mn = (size_t)m * (size_t)n, mxn = (size_t)(m > n ? m : n);
+    size_t pairs = m >= 2 ? (size_t)m * (size_t)(m - 1) / 2 : 0;
+    bool line_seed = opt->seed == SEED_VOGEL || opt->seed == SEED_RUSSELL;
+    bool sorted = opt->feas_scan == FEAS_SCAN_SORTED || line_seed;
+    size_t diff_bytes = pairs * (size_t)n * sizeof(int);
+    if (!rect_uses_pair_kernel(opt) || diff_bytes > diff_cap) diff_bytes = 0;
+    ws_carve(base, &off, sorted ? mn * sizeof(int) : 0, (void **)&sh->order);
+    ws_carve(base, &off, sorted ? mn * sizeof(int) : 0, (void **)&sh->rank);
+    ws_carve(base, &off, opt->feas_scan == FEAS_SCAN_SIMD ? mn * sizeof(int) : 0, (void **)&sh->cost_t);
+    ws_carve(base, &off, line_seed ? mn * sizeof(int) : 0, (void **)&sh->row_order);
+    ws_carve(base, &off, opt->seed == SEED_LEAST_COST ? mn * sizeof(uint64_t) : 0, (void **)&sh->cell_keys);
+    ws_carve(base, &off, diff_bytes, (void **)&sh->pair_diff);
+    size_t shared_bytes = off;
+    ws_carve(base, &off, (size_t)n * sizeof(int), (void **)&scratch->cursor); // scratch build, tidak dibagi
+    ws_carve(base, &off, mxn * sizeof(uint64_t), (void **)&scratch->keys);
+    if (base != NULL) {
+        sh->bytes = shared_bytes;
+        if (!sorted) sh->order = sh->rank = NULL;
+        if (opt->feas_scan != FEAS_SCAN_SIMD) sh->cost_t = NULL;
+        if (!line_seed) sh->row_order = NULL;
+        if (opt->seed != SEED_LEAST_COST) sh->cell_keys = NULL;
+        if (diff_bytes == 0) sh->pair_diff = NULL;
+    }
+    return off;
+}
+
+/* Bangun semua struktur cost yang dibutuhkan opt, sekali untuk semua skenario. Vektor selisih pasangan
+ * baris hanya dibuat jika mode rectangle memakai kernel scan dan ukurannya <= diff_cap byte. */
+static bool cost_shared_build(int m, int n, int cost[m][n], const SsmOptions *opt, size_t diff_cap, SsmCostShared *sh) {
+    CostOrder co;
+    memset(sh, 0, sizeof *sh);
+    size_t need = cost_shared_layout(sh, NULL, m, n, opt, diff_cap, &co);
+    sh->base = aligned_alloc(WS_ALIGN, need);
+    if (sh->base == NULL) return false;
+    cost_shared_layout(sh, sh->base, m, n, opt, diff_cap, &co);
+    sh->m = m; sh->n = n;
+    if (sh->order != NULL) {
+        co.order = sh->order;
+        co.rank = sh->rank;
+        cost_order_build(m, n, cost, &co);
+    }
+    if (sh->cost_t != NULL) cost_transpose(m, n, cost, sh->cost_t);
+    if (sh->row_order != NULL) row_order_build(m, n, cost, sh->row_order, co.keys);
+    if (sh->cell_keys != NULL) cell_keys_build(m, n, cost, sh->cell_keys);
+    if (sh->pair_diff != NULL)
+        for (int r1 = 0; r1 < m; r1++)
+            for (int r2 = r1 + 1; r2 < m; r2++) {
+                int *d = sh->pair_diff + row_pair_index(m, r1, r2) * (size_t)n;
+                for (int c = 0; c < n; c++) d[c] = cost[r1][c] - cost[r2][c];
+            }
+    return true;
+}
+
+static void cost_shared_free(SsmCostShared *sh) {
+    free(sh->base);
+    memset(sh, 0, sizeof *sh);
+}
+
+/* Satu skenario: supply/demand sendiri di atas cost bersama. alloc (m x n) boleh NULL jika hanya cost yang perlu. */
+typedef struct {
+    int *supply, *demand;
+    int *alloc;
+    long long cost;
+    SsmMetrics metrics;
+} SsmScenario;
+
+typedef struct {
+    int m, n;
+    int *cost;
+    SsmScenario *sc;
+    int count;
+    const SsmOptions *opt;
+    const SsmCostShared *shared;
+    atomic_int next, failed;
+} ScenarioPool;
+
+static void *scenario_worker_main(void *arg) {
+    ScenarioPool *p = arg;
+    SsmWorkspace ws = { 0 }; // satu workspace per worker; struktur cost dibaca dari p->shared
+    ws.shared = p->shared;
+    for (int s; (s = atomic_fetch_add(&p->next, 1)) < p->count; ) {
+        SsmScenario *sc = &p->sc[s];
+        if (!ssm_workspace_prepare(&ws, p->m, p->n, p->opt, false)) {
+            sc->cost = -1;
+            atomic_fetch_add(&p->failed, 1);
+            continue;
+        }
+        SsmInstance inst = { p->m, p->n, p->cost, sc->supply, sc->demand, NULL, 0 };
+        sc->cost = solve_instance(&inst, &ws, p->opt);
+        sc->metrics = ws.metrics;
+        if (sc->alloc != NULL) memcpy(sc->alloc, ws.alloc, (size_t)p->m * p->n * sizeof(int));
+    }
+    ssm_workspace_free(&ws);
+    return NULL;
+}
+
+/* Selesaikan count skenario pada matriks cost yang sama dengan nworkers thread (thread pemanggil ikut
+ * bekerja). shared harus dibangun dengan opt yang sama. Kembalikan jumlah skenario yang gagal. */
+static int ssm_solve_scenarios(int m, int n, int cost[m][n], SsmScenario *sc, int count, const SsmOptions *opt,
+                               const SsmCostShared *shared, int nworkers) {
+    SsmOptions o = *opt;
+    o.threads = 1; // paralelisme di level skenario
+    ScenarioPool p = { .m = m, .n = n, .cost = &cost[0][0], .sc = sc, .count = count, .opt = &o, .shared = shared };
+    atomic_init(&p.next, 0);
+    atomic_init(&p.failed, 0);
+    if (nworkers > count) nworkers = count;
+    pthread_t *tids = nworkers > 1 ? malloc((size_t)nworkers * sizeof(pthread_t)) : NULL;
+    int started = 0;
+    for (int w = 1; tids != NULL && w < nworkers; w++) {
+        if (pthread_create(&tids[w], NULL, scenario_worker_main, &p) != 0) break;
+        started++;
+    }
+    scenario_worker_main(&p);
+    for (int w = 1; w <= started; w++) pthread_join(tids[w], NULL);
+    free(tids);
+    return atomic_load(&p.failed);
+}
+
+/* File skenario (teks): "m n", matriks cost m x n, jumlah skenario K, lalu K kali (supply m, demand n) */
+typedef struct {
+    int m, n, count;
+    int *cost;            // m x n
+    int *vectors;         // count x (m+n): supply lalu demand per skenario
+} ScenarioSet;
+
+static void scenario_set_free(ScenarioSet *set) {
+    free(set->cost);
+    free(set->vectors);
+    memset(set, 0, sizeof *set);
+}
+
+static bool load_scenarios_text(const char *path, ScenarioSet *set) {
+    memset(set, 0, sizeof *set);
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    size_t len = 0;
+    char *buf = read_whole_file(fd, &len);
+    close(fd);
+    if (buf == NULL) return false;
+    TextCursor tc = { buf, buf + len };
+    int m, n, k;
+    bool ok = text_next_int(&tc, &m) && text_next_int(&tc, &n) && m > 0 && n > 0;
+    size_t mn = ok ? (size_t)m * (size_t)n : 0;
+    if (ok) ok = (set->cost = malloc(mn * sizeof(int))) != NULL;
+    for (size_t c = 0; ok && c < mn; c++) ok = text_next_int(&tc, &set->cost[c]);
+    ok = ok && text_next_int(&tc, &k) && k > 0;
+    size_t nvec = ok ? (size_t)k * ((size_t)m + n) : 0;
+    if (ok) ok = (set->vectors = malloc(nvec * sizeof(int))) != NULL;
+    for (size_t c = 0; ok && c < nvec; c++) ok = text_next_int(&tc, &set->vectors[c]);
+    free(buf);
+    if (!ok) { scenario_set_free(set); return false; }
+    set->m = m; set->n = n; set->count = k;
+    return true;
+}
+
+/* Muat file skenario, bangun struktur cost sekali, selesaikan semua skenario paralel dan cetak hasilnya */
+static int run_scenarios_file(const char *path, const SsmOptions *opt, int nworkers, size_t diff_cap, bool print_alloc) {
+    double t0 = now_sec();
+    ScenarioSet set;
+    if (!load_scenarios_text(path, &set)) {
+        printf("Gagal membaca file skenario %s\n", path);
+        return 1;
+    }
+    int m = set.m, n = set.n, K = set.count;
+    int (*cost)[n] = (int (*)[n])set.cost;
+    size_t mn = (size_t)m * (size_t)n;
+    SsmScenario *sc = calloc((size_t)K, sizeof(SsmScenario));
+    int *allocs = print_alloc ? malloc((size_t)K * mn * sizeof(int)) : NULL;
+    SsmCostShared sh;
+    double t1 = now_sec();
+    bool ok = sc != NULL && (!print_alloc || allocs != NULL) && cost_shared_build(m, n, cost, opt, diff_cap, &sh);
+    if (!ok) {
+        printf("Memori tidak cukup untuk %d skenario %dx%d\n", K, m, n);
+        free(sc); free(allocs); scenario_set_free(&set);
+        return 1;
+    }
+    for (int s = 0; s < K; s++) {
+        sc[s].supply = set.vectors + (size_t)s * (m + n);
+        sc[s].demand = sc[s].supply + m;
+        sc[s].alloc = allocs != NULL ? allocs + (size_t)s * mn : NULL;
+    }
+    double t2 = now_sec();
+    int failed = ssm_solve_scenarios(m, n, cost, sc, K, opt, &sh, nworkers);
+    double t3 = now_sec();
+
+    for (int s = 0; s < K; s++) {
+        printf("\n### SKENARIO %d\n", s + 1);
+        if (sc[s].cost < 0) { printf("Gagal (memori tidak cukup).\n"); continue; }
+        if (sc[s].alloc != NULL) {
+            printf("Alokasi (baris, kolom, jumlah):");
+            for (size_t c = 0; c < mn; c++)
+                if (sc[s].alloc[c] > 0) printf(" (%zu,%zu,%d)", c / n + 1, c % n + 1, sc[s].alloc[c]);
+            printf("\n");
+        }
+        printf(">>> Total Transportation Cost (final) : %lld\n", sc[s].cost);
+        print_early_stop(stdout, &sc[s].metrics);
+        char name[4096];
+        snprintf(name, sizeof name, "%s#%d", path, s + 1);
+        SsmInstance inst = { m, n, set.cost, sc[s].supply, sc[s].demand, NULL, 0 };
+        print_metrics_json(stdout, name, &inst, opt, &sc[s].metrics);
+    }
+    printf("\n==================== SKENARIO SUMMARY ====================\n");
+    printf(" Skenario              : %d (gagal: %d), instance %dx%d, worker %d\n", K, failed, m, n,
+           nworkers < K ? nworkers : K);
+    printf(" Parse sekali          : %.3f ms\n", (t1 - t0) * 1e3);
+    printf(" Struktur cost bersama : %.3f ms (%.1f MB%s)\n", (t2 - t1) * 1e3, sh.bytes / 1048576.0,
+           sh.pair_diff != NULL ? ", termasuk selisih pasangan baris" : "");
+    printf(" Solve semua skenario  : %.3f ms (%.3f ms per skenario)\n", (t3 - t2) * 1e3, (t3 - t2) * 1e3 / K);
+    printf("==========================================================\n");
+    cost_shared_free(&sh);
+    free(sc);
+    free(allocs);
+    scenario_set_free(&set);
+    return failed == 0 ? 0 : 1;
+}
+
+static bool write_instance_text(FILE *out, int m, int n, const int *cost, const int *supply, const int *demand) {
+    fprintf(out, "%d %d\n", m, n);
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++) fprintf(out, "%d%c", cost[(size_t)i * n + j], j + 1 < n ? ' ' : '\n');
+    for (int i = 0; i < m; i++) fprintf(out, "%d%c", supply[i], i + 1 < m ? ' ' : '\n');
+    for (int j = 0; j < n; j++) fprintf(out, "%d%c", demand[j], j + 1 < n ? ' ' : '\n');
+    return !ferror(out);
+}
+
+/* Benchmark multi-skenario: K skenario acak (supply/demand dasar diskalakan 70-130% per baris/kolom) pada satu
+ * matriks cost uniform. Pembanding: K kali alur main (parse file teks + solve dengan struktur cost dibangun
+ * ulang) vs satu file skenario (parse sekali + struktur bersama) dengan 1 worker dan semua core. */
+static int run_scenario_benchmark(int size, int K, const SsmOptions *opt) {
+    int m = size < 2 ? 2 : size, n = m;
+    size_t mn = (size_t)m * n;
+    int *cost = malloc(mn * sizeof(int));
+    int *base = malloc(((size_t)m + n) * sizeof(int));
+    int *vec = malloc((size_t)K * (m + n) * sizeof(int));
+    long long *ref = malloc((size_t)K * sizeof(long long));
+    char dir[] = "/tmp/ssm-scenario-XXXXXX";
+    if (cost == NULL || base == NULL || vec == NULL || ref == NULL || mkdtemp(dir) == NULL) {
+        fprintf(stderr, "Gagal menyiapkan benchmark skenario\n");
+        free(cost); free(base); free(vec); free(ref);
+        return 1;
+    }
+    generate_instance(GEN_UNIFORM, m, n, (int (*)[n])cost, base, base + m, 2024u);
+    uint64_t s = 99u;
+    for (int k = 0; k < K; k++) {
+        int *sup = vec + (size_t)k * (m + n), *dem = sup + m;
+        long long ts = 0, td = 0;
+        for (int j = 0; j < n; j++) { dem[j] = (int)((long long)base[m + j] * rng_range(&s, 70, 130) / 100); td += dem[j]; }
+        for (int i = 0; i < m; i++) { sup[i] = (int)((long long)base[i] * rng_range(&s, 70, 130) / 100); ts += sup[i]; }
+        for (int i = 0; ts < td; i = (i + 1) % m) { sup[i]++; ts++; } // total supply >= total demand
+    }
+
+    // File input untuk kedua jalur
+    char path[128], scen_path[128];
+    bool ok = true;
+    for (int k = 0; ok && k < K; k++) {
+        snprintf(path, sizeof path, "%s/s%03d.txt", dir, k);
+        FILE *f = fopen(path, "w");
+        const int *sup = vec + (size_t)k * (m + n);
+        ok = f != NULL && write_instance_text(f, m, n, cost, sup, sup + m);
+        if (f != NULL && fclose(f) != 0) ok = false;
+    }
+    snprintf(scen_path, sizeof scen_path, "%s/all.txt", dir);
+    FILE *f = ok ? fopen(scen_path, "w") : NULL;
+    if (f != NULL) {
+        fprintf(f, "%d %d\n", m, n);
+        for (size_t c = 0; c < mn; c++) fprintf(f, "%d%c", cost[c], (c + 1) % n ? ' ' : '\n');
+        fprintf(f, "%d\n", K);
+        for (size_t c = 0; c < (size_t)K * (m + n); c++) fprintf(f, "%d ", vec[c]);
+        fprintf(f, "\n");
+        ok = fclose(f) == 0;
+    } else {
+        ok = false;
+    }
+
+    if (LOG_STEPS) printf("Catatan: jalankan dengan --quiet (atau compile dengan -DVERBOSE=0) agar log tidak ikut terukur.\n");
+    int nproc = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    printf("instance %dx%d, K = %d skenario, rect=%s, seed=%s\n", m, n, K, rect_mode_names[opt->rect_mode],
+           seed_strategies[opt->seed].name);
+    printf("%-32s %12s %14s %9s %7s\n", "jalur", "total_ms", "per_skenario_ms", "speedup", "status");
+
+    // Jalur lama: K kali parse + solve (workspace dipakai ulang seperti loop main)
+    double t0 = now_sec();
+    SsmWorkspace ws = { 0 };
+    for (int k = 0; ok && k < K; k++) {
+        SsmInstance inst;
+        snprintf(path, sizeof path, "%s/s%03d.txt", dir, k);
+        ok = load_instance(path, &ws, opt, &inst);
+        if (ok) ref[k] = solve_instance(&inst, &ws, opt);
+    }
+    ssm_workspace_free(&ws);
+    double base_s = now_sec() - t0;
+    if (ok) printf("%-32s %12.3f %14.3f %8.2fx %7s\n", "K x alur main", base_s * 1e3, base_s * 1e3 / K, 1.0, "-");
+
+    struct { const char *name; int workers; size_t diff_cap; } runs[] = {
+        { "bersama, 1 worker", 1, 0 },
+        { "bersama + selisih, 1 worker", 1, (size_t)1 << 30 },
+        { "bersama, semua core", nproc > 0 ? nproc : 1, 0 },
+    };
+    int failures = ok ? 0 : 1;
+    for (size_t r = 0; ok && r < sizeof runs / sizeof runs[0]; r++) {
+        if (runs[r].diff_cap > 0 && !rect_uses_pair_kernel(opt)) continue;
+        double r0 = now_sec();
+        ScenarioSet set;
+        SsmCostShared sh;
+        SsmScenario *sc = calloc((size_t)K, sizeof(SsmScenario));
+        ok = sc != NULL && load_scenarios_text(scen_path, &set);
+        if (ok && !cost_shared_build(m, n, (int (*)[n])set.cost, opt, runs[r].diff_cap, &sh)) {
+            scenario_set_free(&set);
+            ok = false;
+        }
+        if (!ok) { free(sc); break; }
+        for (int k = 0; k < K; k++) {
+            sc[k].supply = set.vectors + (size_t)k * (m + n);
+            sc[k].demand = sc[k].supply + m;
+        }
+        int failed = ssm_solve_scenarios(m, n, (int (*)[n])set.cost, sc, K, opt, &sh, runs[r].workers);
+        double el = now_sec() - r0;
+        bool same = failed == 0;
+        for (int k = 0; k < K; k++) same = same && sc[k].cost == ref[k];
+        failures += !same;
+        char label[64];
+        snprintf(label, sizeof label, "%s%s", runs[r].name, runs[r].diff_cap > 0 && sh.pair_diff == NULL ? " (>1GB)" : "");
+        printf("%-32s %12.3f %14.3f %8.2fx %7s\n", label, el * 1e3, el * 1e3 / K, base_s / (el > 1e-9 ? el : 1e-9),
+               same ? "SAMA" : "BEDA");
+        fflush(stdout);
+        cost_shared_free(&sh);
+        scenario_set_free(&set);
+        free(sc);
+    }
+
+    for (int k = 0; k < K; k++) {
+        snprintf(path, sizeof path, "%s/s%03d.txt", dir, k);
+        unlink(path);
+    }
+    unlink(scen_path);
+    rmdir(dir);
+    free(cost); free(base); free(vec); free(ref);
+    return failures == 0 ? 0 : 1;
+}
+
+/* ==================== Portfolio: banyak varian solve paralel pada instance yang sama ==================== */
+
+/* Varian ke-v dari opt dasar. Varian 0 = opt dasar kecuali feas_scan yang selalu sorted (slc-nya identik dengan
+ * simd, jadi hasilnya sama dengan satu solve biasa dan portfolio tidak pernah lebih buruk), varian 1..3 = kombinasi aturan flc x first/best-improvement dengan tie deterministik,
+ * varian >= 4 = kombinasi yang sama berulang dengan tie-break acak (seed berbeda per varian). */
+static void portfolio_variant(const SsmOptions *base, int v, SsmOptions *o) {
+    *o = *base;
+    o->threads = 1;                  // paralelisme di level varian
+    o->feas_scan = FEAS_SCAN_SORTED; // tie acak butuh urutan cost; slc-nya identik dengan mode simd
+    if (v == 0) return;
+    o->flc_rule = (v & 1) ? FLC_COSTLIEST : FLC_FIRST;
+    if (v & 2) o->pivot = PIVOT_FIRST;
+    if (v >= 4) o->tie_seed = tie_priority(0x5EED5EEDULL, (uint64_t)v, 0) | 1;
+}
+
+// Opsi CLI yang mereproduksi varian (kosong = opsi dasar)
+static void portfolio_variant_flags(const SsmOptions *o, char *buf, size_t len) {
+    int w = 0;
+    buf[0] = '\0';
+    if (o->flc_rule != FLC_FIRST) w += snprintf(buf + w, len - (size_t)w, " --flc=%s", flc_rule_names[o->flc_rule]);
+    if (o->pivot != PIVOT_BEST) w += snprintf(buf + w, len - (size_t)w, " --improve=%s", pivot_rule_names[o->pivot]);
+    if (o->tie_seed != 0) snprintf(buf + w, len - (size_t)w, " --tie-seed=%llu", (unsigned long long)o->tie_seed);
+}
+
+typedef struct {
+    SsmOptions opt;
+    SsmWorkspace ws;      // workspace (arena) milik varian ini; struktur cost dibaca dari PortfolioRun.shared
+    long long cost;       // -1 = gagal (memori)
+    long long work;
+    uint64_t ns;
+    bool dominated;
+} PortfolioVariant;
+
+typedef struct {
+    const SsmInstance *inst;
+    const SsmCostShared *shared;
+    PortfolioVariant *var;
+    int count;
+    atomic_int next;
+    SsmIncumbent incumbent;
+} PortfolioRun;
+
+static void portfolio_publish(PortfolioRun *p, long long cost, long long work) {
+    pthread_mutex_lock(&p->incumbent.lock);
+    if (cost < p->incumbent.cost) {
+        p->incumbent.cost = cost;
+        p->incumbent.work = work;
+    }
+    pthread_mutex_unlock(&p->incumbent.lock);
+}
+
+static void *portfolio_worker_main(void *arg) {
+    PortfolioRun *p = arg;
+    for (int v; (v = atomic_fetch_add(&p->next, 1)) < p->count; ) {
+        PortfolioVariant *pv = &p->var[v];
+        SsmWorkspace *ws = &pv->ws;
+        ws->shared = p->shared;
+        ws->deadline.incumbent = &p->incumbent;
+        ws->deadline.dominance = v != 0;
+        if (!ssm_workspace_prepare(ws, p->inst->m, p->inst->n, &pv->opt, false)) { pv->cost = -1; continue; }
+        uint64_t t0 = now_ns();
+        pv->cost = solve_instance(p->inst, ws, &pv->opt);
+        pv->ns = now_ns() - t0;
+        pv->work = ws->deadline.work;
+        pv->dominated = ws->deadline.dominated;
+        if (!pv->dominated) portfolio_publish(p, pv->cost, pv->work);
+    }
+    return NULL;
+}
+
+/* Solve instance dengan count varian paralel (satu thread per varian, thread pemanggil ikut bekerja).
+ * Varian berbagi incumbent: yang terdominasi berhenti lebih awal (lihat SsmIncumbent). Alokasi dan metrik
+ * pemenang (cost terkecil, tie: indeks varian terkecil) disalin ke ws; kembalikan cost-nya, -1 jika gagal. */
+static long long solve_portfolio(const SsmInstance *inst, SsmWorkspace *ws, const SsmOptions *opt, int count,
+                                 size_t diff_cap) {
+    int m = inst->m, n = inst->n;
+    int (*cost)[n] = (int (*)[n])inst->cost;
+    if (count < 1) count = 1;
+    PortfolioRun p = { .inst = inst, .count = count };
+    p.var = calloc((size_t)count, sizeof(PortfolioVariant));
+    for (int v = 0; p.var != NULL && v < count; v++) portfolio_variant(opt, v, &p.var[v].opt);
+    SsmCostShared sh;
+    if (p.var == NULL || !cost_shared_build(m, n, cost, &p.var[0].opt, diff_cap, &sh)) {
+        printf("Memori tidak cukup untuk portfolio %d varian %dx%d\n", count, m, n);
+        free(p.var);
+        return -1;
+    }
+    p.shared = &sh;
+    atomic_init(&p.next, 0);
+    p.incumbent.cost = LLONG_MAX;
+    p.incumbent.work = 0;
+    atomic_init(&p.incumbent.bound, LLONG_MIN);
+    pthread_mutex_init(&p.incumbent.lock, NULL);
+
+    uint64_t t0 = now_ns();
+    pthread_t *tids = count > 1 ? malloc((size_t)count * sizeof(pthread_t)) : NULL;
+    int started = 0;
+    for (int w = 1; tids != NULL && w < count; w++) {
+        if (pthread_create(&tids[w], NULL, portfolio_worker_main, &p) != 0) break;
+        started++;
+    }
+    portfolio_worker_main(&p);
+    for (int w = 1; w <= started; w++) pthread_join(tids[w], NULL);
+    free(tids);
+    uint64_t wall = now_ns() - t0;
+    pthread_mutex_destroy(&p.incumbent.lock);
+
+    int win = -1;
+    for (int v = 0; v < count; v++)
+        if (p.var[v].cost >= 0 && (win < 0 || p.var[v].cost < p.var[win].cost)) win = v;
+
+    printf("\n[portfolio] %d varian, %d thread, wall %.3f ms\n", count, started + 1, wall / 1e6);
+    printf("  varian %14s %14s %10s  %-12s opsi\n", "cost", "kerja", "ms", "status");
+    for (int v = 0; v < count; v++) {
+        PortfolioVariant *pv = &p.var[v];
+        char flags[128];
+        portfolio_variant_flags(&pv->opt, flags, sizeof flags);
+        const char *status = pv->cost < 0 ? "gagal" : pv->dominated ? "dihentikan" :
+                             pv->ws.metrics.early_stop ? "batas" : "selesai";
+        printf("  %6d %14lld %14lld %10.3f  %-12s%s%s\n", v, pv->cost, pv->work, pv->ns / 1e6, status,
+               flags[0] ? flags : " (dasar)", v == win ? "  <== pemenang" : "");
+    }
+
+    long long best = -1;
+    if (win >= 0) {
+        best = p.var[win].cost;
+        memcpy(ws->alloc, p.var[win].ws.alloc, (size_t)m * n * sizeof(int));
+        ws->metrics = p.var[win].ws.metrics;
+    }
+    for (int v = 0; v < count; v++) ssm_workspace_free(&p.var[v].ws);
+    cost_shared_free(&sh);
+    free(p.var);
+    return best;
+}
+
+/* Instance kecil dengan optimum yang dihitung di luar solver ini (enumerasi semua alokasi integer), termasuk
+ * kasus degenerate dan supply > demand. Bersama testcase/ dengan optimal_solution, memeriksa network simplex
+ * yang dipakai harness sebagai referensi eksak. */
+typedef struct {
+    const char *name;
+    int m, n;
+    const int *cost, *supply, *demand;
+    long long optimum;
+} BenchReference;
+
+static const BenchReference bench_references[] = {
+    { "silang-2x2", 2, 2, (const int[]){ 1, 4, 2, 3 }, (const int[]){ 5, 5 }, (const int[]){ 5, 5 }, 20 },
+    { "sisa-3x2", 3, 2, (const int[]){ 8, 6, 3, 9, 5, 5 }, (const int[]){ 10, 4, 10 }, (const int[]){ 7, 9 }, 74 },
+    { "diagonal-3x3", 3, 3, (const int[]){ 1, 9, 9, 9, 1, 9, 9, 9, 1 }, (const int[]){ 5, 5, 5 },
+      (const int[]){ 5, 5, 5 }, 15 },
+    { "campur-3x4", 3, 4, (const int[]){ 4, 1, 3, 6, 2, 5, 2, 4, 7, 3, 1, 2 }, (const int[]){ 6, 7, 5 },
+      (const int[]){ 4, 5, 5, 3 }, 27 },
+};
+
+// Seed, rectangle, lalu network simplex seperti satu baris harness; -1 jika network simplex gagal
+static long long bench_exact_cost(int m, int n, int cost[m][n], int supply[m], int demand[n], const SsmOptions *opt,
+                                  SsmWorkspace *ws) {
+    int (*alloc)[n] = (int (*)[n])ws->alloc;
+    ssm_solve_begin(ws);
+    build_initial_solution(m, n, cost, supply, demand, alloc, opt, ws);
+    improve_with_rectangles(m, n, cost, supply, demand, alloc, opt, ws);
+    return solve_exact_network_simplex(m, n, cost, supply, demand, alloc, ws) ? total_biaya(m, n, cost, alloc) : -1;
+}
+
+/* Cek referensi eksak terhadap optimum yang diketahui (ke stderr agar CSV tetap bersih); kembalikan jumlah beda */
+static int bench_check_references(const SsmOptions *opt, SsmWorkspace *ws) {
+    int checked = 0, failures = 0;
+    for (size_t r = 0; r < sizeof bench_references / sizeof bench_references[0]; r++) {
+        const BenchReference *br = &bench_references[r];
+        int m = br->m, n = br->n;
+        if (!ssm_workspace_prepare(ws, m, n, opt, true)) return failures + 1;
+        memcpy(ws->cost, br->cost, (size_t)m * n * sizeof(int));
+        memcpy(ws->supply, br->supply, (size_t)m * sizeof(int));
+        memcpy(ws->demand, br->demand, (size_t)n * sizeof(int));
+        long long got = bench_exact_cost(m, n, (int (*)[n])ws->cost, ws->supply, ws->demand, opt, ws);
+        checked++;
+        if (got != br->optimum) {
+            fprintf(stderr, "referensi %s: network simplex %lld, optimum %lld\n", br->name, got, br->optimum);
+            failures++;
+        }
+    }
+    for (int k = 1; k <= 35; k++) {
+        if (optimal_solution[k] == -1) continue;
+        char filename[20];
+        SsmInstance inst;
+        sprintf(filename, "testcase/n%02d.txt", k);
+        if (access(filename, R_OK) != 0 || !load_instance(filename, ws, opt, &inst)) continue;
+        int m = inst.m, n = inst.n;
+        long long got = bench_exact_cost(m, n, (int (*)[n])inst.cost, inst.supply, inst.demand, opt, ws);
+        checked++;
+        if (got != optimal_solution[k]) {
+            fprintf(stderr, "referensi %s: network simplex %lld, optimum %d\n", filename, got, optimal_solution[k]);
+            failures++;
+        }
+        instance_release(&inst);
+    }
+    fprintf(stderr, "Referensi eksak: %d dari %d instance dengan optimum diketahui cocok.\n", checked - failures, checked);
+    return failures;
+}
+
+/* Harness benchmark: semua jenis generator x ukuran 10..max_size, waktu per fase, iterasi, cost heuristik dan
+ * gap terhadap optimum dari network simplex (referensi eksak, dicek dulu dengan bench_check_references). Output
+ * CSV ke stdout. */
+static int run_bench_harness(int max_size, const SsmOptions *base_opt) {
+    static const int sizes[] = { 10, 20, 50, 100, 200, 500, 1000, 2000 };
+    SsmOptions opt = *base_opt;
+    opt.exact = true; // workspace perlu pohon network simplex untuk referensi
+    SsmWorkspace ws = { 0 };
+    int failures = bench_check_references(&opt, &ws);
+
+    printf("type,m,n,seed,rect,seed_s,rect_s,exact_s,feas_iters,rect_moves,rect_evaluated,ns_pivots,"
+           "seed_cost,heur_cost,opt_cost,gap_pct\n");
+    for (int g = 0; g < GEN_TYPE_COUNT; g++) {
+        for (size_t k = 0; k < sizeof sizes / sizeof sizes[0] && sizes[k] <= max_size; k++) {
+            int m = sizes[k], n = sizes[k];
+            if (!ssm_workspace_prepare(&ws, m, n, &opt, true)) {
+                fprintf(stderr, "gagal alokasi workspace %dx%d\n", m, n);
+                break;
+            }
+            int (*cost)[n] = (int (*)[n])ws.cost;
+            int (*alloc)[n] = (int (*)[n])ws.alloc;
+            generate_instance((GenType)g, m, n, cost, ws.supply, ws.demand, 777u + 1000u * (uint64_t)g + (uint64_t)k);
+            SsmMetrics *mt = &ws.metrics;
+            ssm_solve_begin(&ws);
+
+            uint64_t t0 = now_ns();
+            build_initial_solution(m, n, cost, ws.supply, ws.demand, alloc, &opt, &ws);
+            uint64_t t1 = now_ns();
+            mt->seed_cost = total_biaya(m, n, cost, alloc);
+            improve_with_rectangles(m, n, cost, ws.supply, ws.demand, alloc, &opt, &ws);
+            uint64_t t2 = now_ns();
+            long long heur = total_biaya(m, n, cost, alloc);
+            bool exact_ok = solve_exact_network_simplex(m, n, cost, ws.supply, ws.demand, alloc, &ws);
+            uint64_t t3 = now_ns();
+            long long best = exact_ok ? total_biaya(m, n, cost, alloc) : -1;
+
+            printf("%s,%d,%d,%s,%s,%.6f,%.6f,%.6f,%lld,%lld,%lld,%lld,%lld,%lld,%lld,", gen_type_names[g], m, n,
+                   seed_strategies[opt.seed].name, rect_mode_names[opt.rect_mode], (double)(t1 - t0) * 1e-9,
+                   (double)(t2 - t1) * 1e-9, (double)(t3 - t2) * 1e-9, mt->feas_iters, mt->rect_moves,
+                   mt->rect_evaluated, mt->ns_pivots, mt->seed_cost, heur, best);
+            if (best > 0) printf("%.4f\n", 100.0 * (double)(heur - best) / (double)best);
+            else printf("\n");
+            fflush(stdout);
+        }
+    }
+    ssm_workspace_free(&ws);
+    return failures == 0 ? 0 : 1;
+}
+
+/* ==================== Mode batch paralel ==================== */
+
+/* Setiap task = satu file instance. Worker punya rentang task sendiri [head, end) yang dikemas dalam satu
+ * atomic 64 bit: pemilik mengambil dari head, pencuri mengambil satu task dari end, keduanya lewat CAS.
+ * head hanya naik dan end hanya turun sehingga tidak ada ABA. Output tiap task ditulis ke buffer sendiri
+ * (open_memstream) dan dicetak oleh thread utama sesuai urutan input. */
+typedef struct {
+    const char *path;
+    char *out;
+    size_t out_len;
+    bool done;           // dilindungi BatchPool.lock (hanya untuk sinyal ke flusher)
+} BatchTask;
+
+typedef struct {
+    _Alignas(64) _Atomic uint64_t range; // head (32 bit bawah), end (32 bit atas)
+} BatchDeque;
+
+typedef struct {
+    BatchTask *tasks;
+    int ntasks, nworkers;
+    BatchDeque *deques;
+    const SsmOptions *opt;
+    atomic_int solved, optimal, not_optimal, no_ref, failed, steals;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} BatchPool;
+
+typedef struct {
+    BatchPool *pool;
+    int id;
+} BatchWorker;
+
+static uint64_t batch_pack(uint32_t head, uint32_t end) { return (uint64_t)end << 32 | head; }
+
+static int batch_pop(BatchDeque *d) {
+    uint64_t r = atomic_load(&d->range);
+    for (;;) {
+        uint32_t head = (uint32_t)r, end = (uint32_t)(r >> 32);
+        if (head >= end) return -1;
+        if (atomic_compare_exchange_weak(&d->range, &r, batch_pack(head + 1, end))) return (int)head;
+    }
+}
+
+static int batch_steal(BatchDeque *d) {
+    uint64_t r = atomic_load(&d->range);
+    for (;;) {
+        uint32_t head = (uint32_t)r, end = (uint32_t)(r >> 32);
+        if (head >= end) return -1;
+        if (atomic_compare_exchange_weak(&d->range, &r, batch_pack(head, end - 1))) return (int)(end - 1);
+    }
+}
+
+// Indeks testcase dari nama file nXX.txt (untuk cek optimal_solution), -1 jika bukan testcase
+static int testcase_index(const char *path) {
+    const char *base = strrchr(path, '/');
+    base = base != NULL ? base + 1 : path;
+    int k = 0, len = 0;
+    if (sscanf(base, "n%2d.txt%n", &k, &len) != 1 || base[len] != '\0' || k < 1 || k > 35) return -1;
+    return k;
+}
+
+static void batch_run_task(BatchPool *p, BatchTask *task, SsmWorkspace *ws) {
+    FILE *out = open_memstream(&task->out, &task->out_len);
+    if (out == NULL) {
+        atomic_fetch_add(&p->failed, 1);
+    } else {
+        SsmInstance inst;
+        fprintf(out, "### %s\n", task->path);
+        if (!load_instance(task->path, ws, p->opt, &inst)) {
+            fprintf(out, "Gagal membaca instance %s, file dilewati.\n", task->path);
+            atomic_fetch_add(&p->failed, 1);
+        } else {
+            long long tot = solve_instance(&inst, ws, p->opt);
+            int k = testcase_index(task->path);
+            fprintf(out, ">>> Total Transportation Cost (final) : %lld\n", tot);
+            print_early_stop(out, &ws->metrics);
+            if (k < 0 || optimal_solution[k] == -1) {
+                atomic_fetch_add(&p->no_ref, 1);
+            } else if (tot == (long long)optimal_solution[k]) {
+                fprintf(out, ">>> Status: OPTIMAL (sesuai nilai yang diharapkan %d)\n", optimal_solution[k]);
+                atomic_fetch_add(&p->optimal, 1);
+            } else {
+                fprintf(out, ">>> Status: BELUM OPTIMAL (seharusnya %d, diperoleh %lld)\n", optimal_solution[k], tot);
+                atomic_fetch_add(&p->not_optimal, 1);
+            }
+            print_metrics_json(out, task->path, &inst, p->opt, &ws->metrics);
+            instance_release(&inst);
+            atomic_fetch_add(&p->solved, 1);
+        }
+        fclose(out);
+    }
+    pthread_mutex_lock(&p->lock);
+    task->done = true;
+    pthread_cond_broadcast(&p->cond);
+    pthread_mutex_unlock(&p->lock);
+}
+
+static void *batch_worker_main(void *arg) {
+    BatchWorker *w = arg;
+    BatchPool *p = w->pool;
+    SsmWorkspace ws = { 0 }; // workspace dipakai ulang untuk semua task worker ini
+    for (;;) {
+        int t = batch_pop(&p->deques[w->id]);
+        for (int k = 1; t < 0 && k < p->nworkers; k++) {
+            t = batch_steal(&p->deques[(w->id + k) % p->nworkers]);
+            if (t >= 0) atomic_fetch_add(&p->steals, 1);
+        }
+        if (t < 0) break; // semua deque kosong: tidak ada task yang tersisa
+        batch_run_task(p, &p->tasks[t], &ws);
+    }
+    ssm_workspace_free(&ws);
+    return NULL;
+}
+
+static int cmp_cstr(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+/* Kumpulkan path dari direktori (file reguler, urut nama) atau manifest (satu path per baris, # = komentar) */
+static char **batch_collect_paths(const char *src, int *count) {
+    struct stat st;
+    char **list = NULL;
+    int n = 0, cap = 0;
+    *count = 0;
+    if (stat(src, &st) != 0) return NULL;
+    if (S_ISDIR(st.st_mode)) {
+        DIR *d = opendir(src);
+        if (d == NULL) return NULL;
+        struct dirent *e;
+        while ((e = readdir(d)) != NULL) {
+            if (e->d_name[0] == '.') continue;
+            size_t len = strlen(src) + strlen(e->d_name) + 2;
+            char *path = malloc(len);
+            snprintf(path, len, "%s/%s", src, e->d_name);
+            if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) { free(path); continue; }
+            if (n == cap) { cap = cap ? 2 * cap : 64; list = realloc(list, (size_t)cap * sizeof(char *)); }
+            list[n++] = path;
+        }
+        closedir(d);
+        if (n > 0) qsort(list, (size_t)n, sizeof(char *), cmp_cstr);
+    } else {
+        FILE *f = fopen(src, "r");
+        if (f == NULL) return NULL;
+        char line[4096];
+        while (fgets(line, sizeof line, f) != NULL) {
+            size_t len = strcspn(line, "\r\n");
+            line[len] = '\0';
+            if (len == 0 || line[0] == '#') continue;
+            if (n == cap) { cap = cap ? 2 * cap : 64; list = realloc(list, (size_t)cap * sizeof(char *)); }
+            list[n++] = strdup(line);
+        }
+        fclose(f);
+    }
+    *count = n;
+    return list;
+}
+
+/* Selesaikan semua instance dari direktori/manifest secara paralel, cetak output per file sesuai urutan input */
+static int run_batch(const char *src, const SsmOptions *base_opt, int nworkers) {
+    int ntasks = 0;
+    char **paths = batch_collect_paths(src, &ntasks);
+    if (paths == NULL || ntasks == 0) {
+        printf("Tidak ada instance di %s\n", src);
+        free(paths);
+        return 1;
+    }
+    SsmOptions opt = *base_opt;
+    opt.threads = 1; // paralelisme di level instance, bukan di dalam pencarian rectangle
+    if (nworkers > ntasks) nworkers = ntasks;
+    if (nworkers < 1) nworkers = 1;
+
+    BatchPool p = { .ntasks = ntasks, .nworkers = nworkers, .opt = &opt };
+    p.tasks = calloc((size_t)ntasks, sizeof(BatchTask));
+    p.deques = aligned_alloc(64, (size_t)nworkers * sizeof(BatchDeque));
+    BatchWorker *workers = malloc((size_t)nworkers * sizeof(BatchWorker));
+    pthread_t *tids = malloc((size_t)nworkers * sizeof(pthread_t));
+    pthread_mutex_init(&p.lock, NULL);
+    pthread_cond_init(&p.cond, NULL);
+    for (int t = 0; t < ntasks; t++) p.tasks[t].path = paths[t];
+    // Rentang awal: blok kontigu per worker
+    for (int w = 0; w < nworkers; w++) {
+        uint32_t lo = (uint32_t)((long long)ntasks * w / nworkers), hi = (uint32_t)((long long)ntasks * (w + 1) / nworkers);
+        atomic_init(&p.deques[w].range, batch_pack(lo, hi));
+    }
+
+    double t0 = now_sec();
+    int started = 0;
+    for (int w = 0; w < nworkers; w++) {
+        workers[w] = (BatchWorker){ &p, w };
+        if (pthread_create(&tids[w], NULL, batch_worker_main, &workers[w]) != 0) break;
+        started++;
+    }
+    if (started == 0) {
+        // Tanpa thread tambahan: kerjakan semua task di thread ini
+        workers[0] = (BatchWorker){ &p, 0 };
+        p.nworkers = 1;
+        atomic_store(&p.deques[0].range, batch_pack(0, (uint32_t)ntasks));
+        batch_worker_main(&workers[0]);
+    }
+
+    // Flush sesuai urutan input segera setelah task berikutnya selesai
+    for (int t = 0; t < ntasks; t++) {
+        pthread_mutex_lock(&p.lock);
+        while (!p.tasks[t].done) pthread_cond_wait(&p.cond, &p.lock);
+        pthread_mutex_unlock(&p.lock);
+        if (p.tasks[t].out != NULL) fwrite(p.tasks[t].out, 1, p.tasks[t].out_len, stdout);
+        free(p.tasks[t].out);
+    }
+    for (int w = 0; w < started; w++) pthread_join(tids[w], NULL);
+    double elapsed = now_sec() - t0;
+
+    printf("\n====================== BATCH SUMMARY ======================\n");
+    printf(" Worker                : %d (pencurian task: %d)\n", started > 0 ? started : 1, atomic_load(&p.steals));
+    printf(" Instance diselesaikan : %d dari %d (gagal: %d)\n", atomic_load(&p.solved), ntasks, atomic_load(&p.failed));
+    printf(" Optimal / belum / tanpa referensi : %d / %d / %d\n",
+           atomic_load(&p.optimal), atomic_load(&p.not_optimal), atomic_load(&p.no_ref));
+    printf(" Waktu total           : %.3f s (%.1f instance/detik)\n", elapsed, elapsed > 0 ? ntasks / elapsed : 0.0);
+    printf("===========================================================\n");
+
+    int rc = atomic_load(&p.failed) == 0 ? 0 : 1;
+    pthread_mutex_destroy(&p.lock);
+    pthread_cond_destroy(&p.cond);
+    for (int t = 0; t < ntasks; t++) free(paths[t]);
+    free(paths);
+    free(p.tasks);
+    free(p.deques);
+    free(workers);
+    free(tids);
+    return rc;
+}
+
+/* ==================== Mode server: workspace tetap hangat, request lewat Unix socket atau stdin ==================== */
+
+/* Framing: setiap frame = panjang payload (uint32) lalu payload; semua field int32/uint32 little-endian.
+ * Request : type, id, lalu untuk SRV_SOLVE: m, n, cost (m*n row-major), supply (m), demand (n) -- sama dengan isi
+ *           file biner SSMB tanpa header.
+ * Response: id, status, lalu untuk SRV_SOLVE dengan status SRV_OK: cost (int64), jumlah sel k, k kali
+ *           (row, col, qty) 0-based; untuk SRV_STATS: satu objek JSON (teks).
+ * Request dikerjakan paralel oleh pool worker, jadi response bisa keluar tidak urut; id menghubungkannya. */
+#define SRV_SOLVE 1u
+#define SRV_STATS 2u
+#define SRV_OK 0u
+#define SRV_BAD_REQUEST 1u
+#define SRV_NO_MEMORY 2u
+#define SRV_DEFAULT_MAX_CELLS (1LL << 22) // batas m*n per request (--serve-max-cells)
+#define SRV_QUEUE_CAP 256                 // request yang menunggu worker
+#define SRV_QUEUE_BYTES (256u << 20)      // total payload yang boleh tertahan di antrean dan worker
+#define SRV_LATENCY_WINDOW 4096           // p50/p99 dihitung dari latensi request terakhir sebanyak ini
+
+typedef struct {
+    int in_fd, out_fd;
+    bool owns_fds;               // socket: ditutup saat referensi terakhir dilepas; stdin/stdout tidak
+    pthread_mutex_t write_lock;  // satu frame response ditulis utuh
+    atomic_int refs;             // reader + request yang belum dijawab
+    atomic_bool broken;          // tulis gagal (klien putus): response berikutnya dibuang
+} ServerConn;
+
+typedef struct {
+    ServerConn *conn;
+    uint8_t *frame;              // payload request, dimiliki job
+    uint32_t len;
+    uint64_t t_recv;             // now_ns saat frame selesai dibaca
+} ServerJob;
+
+typedef struct {
+    SsmOptions opt;
+    int nworkers;
+    long long max_cells;
+    uint64_t t_start;
+    pthread_mutex_t lock;        // antrean, reservasi dan statistik
+    pthread_cond_t not_empty, not_full;
+    ServerJob queue[SRV_QUEUE_CAP];
+    int head, count, reserved;   // reserved: slot yang sudah dipesan reader yang masih membaca payload
+    size_t held_bytes;           // payload yang dipesan, diantrekan atau sedang di-solve
+    bool stopping;
+    uint64_t latency[SRV_LATENCY_WINDOW]; // ring, ns dari frame diterima sampai response ditulis
+    long long served, failed;
+    pthread_t *tids;
+    int started;
+} Server;
+
+static bool srv_read_full(int fd, void *buf, size_t len) {
+    for (size_t got = 0; got < len; ) {
+        ssize_t r = read(fd, (char *)buf + got, len - got);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        got += (size_t)r;
+    }
+    return true;
+}
+
+// Lewati sisa payload yang tidak dipakai tanpa mengalokasikannya
+static bool srv_skip(int fd, size_t len) {
+    char buf[4096];
+    while (len > 0) {
+        size_t k = len < sizeof buf ? len : sizeof buf;
+        if (!srv_read_full(fd, buf, k)) return false;
+        len -= k;
+    }
+    return true;
+}
+
+static bool srv_write_full(int fd, const void *buf, size_t len) {
+    for (size_t put = 0; put < len; ) {
+        ssize_t w = write(fd, (const char *)buf + put, len - put);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        put += (size_t)w;
+    }
+    return true;
+}
+
+static void srv_conn_unref(ServerConn *c) {
+    if (atomic_fetch_sub(&c->refs, 1) != 1) return;
+    if (c->owns_fds) close(c->in_fd);
+    pthread_mutex_destroy(&c->write_lock);
+    free(c);
+}
+
+/* buf[0..4) diisi panjang payload, payload mulai di buf + 4 */
+static void srv_send(ServerConn *c, uint8_t *buf, uint32_t payload_len) {
+    memcpy(buf, &payload_len, 4);
+    pthread_mutex_lock(&c->write_lock);
+    if (!atomic_load(&c->broken) && !srv_write_full(c->out_fd, buf, 4 + (size_t)payload_len))
+        atomic_store(&c->broken, true);
+    pthread_mutex_unlock(&c->write_lock);
+}
+
+static void srv_send_status(ServerConn *c, uint32_t id, uint32_t status) {
+    uint8_t buf[12];
+    memcpy(buf + 4, &id, 4);
+    memcpy(buf + 8, &status, 4);
+    srv_send(c, buf, 8);
+}
+
+// Request ditolak tanpa masuk antrean (dihitung sebagai gagal)
+static void srv_reject(Server *s, ServerConn *c, uint32_t id) {
+    pthread_mutex_lock(&s->lock);
+    s->failed++;
+    pthread_mutex_unlock(&s->lock);
+    srv_send_status(c, id, SRV_BAD_REQUEST);
+}
+
+static void srv_send_stats(Server *s, ServerConn *c, uint32_t id) {
+    static uint64_t window[SRV_LATENCY_WINDOW]; // hanya dipakai di bawah s->lock
+    char json[512];
+    pthread_mutex_lock(&s->lock);
+    long long served = s->served, failed = s->failed;
+    int k = served < SRV_LATENCY_WINDOW ? (int)served : SRV_LATENCY_WINDOW, queued = s->count;
+    memcpy(window, s->latency, (size_t)k * sizeof(uint64_t));
+    qsort(window, (size_t)k, sizeof(uint64_t), cmp_u64);
+    // Nearest-rank: persentil q = elemen ke-ceil(q*k)
+    double p50 = k > 0 ? window[(k + 1) / 2 - 1] / 1e3 : 0.0, p99 = k > 0 ? window[(99 * k + 99) / 100 - 1] / 1e3 : 0.0;
+    double mx = k > 0 ? window[k - 1] / 1e3 : 0.0;
+    pthread_mutex_unlock(&s->lock);
+    int len = snprintf(json, sizeof json, "{\"served\":%lld,\"failed\":%lld,\"queued\":%d,\"workers\":%d,\"window\":%d,"
+                       "\"p50_us\":%.1f,\"p99_us\":%.1f,\"max_us\":%.1f,\"uptime_s\":%.3f}",
+                       served, failed, queued, s->nworkers, k, p50, p99, mx, (now_ns() - s->t_start) / 1e9);
+    uint8_t buf[12 + sizeof json];
+    uint32_t status = SRV_OK;
+    memcpy(buf + 4, &id, 4);
+    memcpy(buf + 8, &status, 4);
+    memcpy(buf + 12, json, (size_t)len);
+    srv_send(c, buf, 8 + (uint32_t)len);
+}
+
+/* Supply/demand harus non-negatif, totalnya muat di int32, dan total supply >= total demand (kelebihan supply
+ * tetap tidak terkirim, seperti pada solve biasa). Selain itu hasilnya bukan alokasi yang memenuhi batasan. */
+static bool srv_instance_valid(const SsmInstance *inst) {
+    long long sum_s = 0, sum_d = 0;
+    for (int i = 0; i < inst->m; i++) {
+        if (inst->supply[i] < 0) return false;
+        sum_s += inst->supply[i];
+    }
+    for (int j = 0; j < inst->n; j++) {
+        if (inst->demand[j] < 0) return false;
+        sum_d += inst->demand[j];
+    }
+    return sum_s <= INT_MAX && sum_d <= sum_s;
+}
+
+/* Solve satu request di workspace worker; response (termasuk 4 byte panjang) ditulis ke *out. Ukuran frame
+ * sudah dicek reader (server_read_loop). */
+static uint32_t srv_solve(const ServerJob *job, SsmWorkspace *ws, const SsmOptions *opt, uint8_t **out,
+                          size_t *out_cap, uint32_t *out_len) {
+    int32_t hdr[4];
+    memcpy(hdr, job->frame, sizeof hdr);
+    int m = hdr[2], n = hdr[3];
+    int *data = (int *)(job->frame + sizeof hdr); // malloc: selaras untuk int
+    size_t mn = (size_t)m * (size_t)n;
+    SsmInstance inst = { m, n, data, data + mn, data + mn + m, NULL, 0 };
+    if (!srv_instance_valid(&inst)) return SRV_BAD_REQUEST;
+    if (!ssm_workspace_prepare(ws, m, n, opt, false)) return SRV_NO_MEMORY;
+    long long cost = solve_instance(&inst, ws, opt);
+
+    size_t cells = 0;
+    for (size_t c = 0; c < mn; c++) cells += ws->alloc[c] > 0;
+    size_t need = 4 + 8 + 8 + 4 + cells * 12;
+    if (need > *out_cap) {
+        uint8_t *grown = realloc(*out, need);
+        if (grown == NULL) return SRV_NO_MEMORY;
+        *out = grown;
+        *out_cap = need;
+    }
+    uint8_t *p = *out + 4;
+    uint32_t id = (uint32_t)hdr[1], status = SRV_OK, count = (uint32_t)cells;
+    memcpy(p, &id, 4); memcpy(p + 4, &status, 4); memcpy(p + 8, &cost, 8); memcpy(p + 16, &count, 4);
+    p += 20;
+    for (size_t c = 0; c < mn; c++) {
+        if (ws->alloc[c] <= 0) continue;
+        int32_t cell[3] = { (int32_t)(c / (size_t)n), (int32_t)(c % (size_t)n), ws->alloc[c] };
+        memcpy(p, cell, sizeof cell);
+        p += sizeof cell;
+    }
+    *out_len = (uint32_t)(need - 4);
+    return SRV_OK;
+}
+
+static void *server_worker_main(void *arg) {
+    Server *s = arg;
+    SsmWorkspace ws = { 0 }; // tetap hidup antar request: hanya tumbuh jika instance lebih besar
+    uint8_t *out = NULL;
+    size_t out_cap = 0;
+    for (;;) {
+        pthread_mutex_lock(&s->lock);
+        while (s->count == 0 && !s->stopping) pthread_cond_wait(&s->not_empty, &s->lock);
+        if (s->count == 0) { pthread_mutex_unlock(&s->lock); break; }
+        ServerJob job = s->queue[s->head];
+        s->head = (s->head + 1) % SRV_QUEUE_CAP;
+        s->count--;
+        pthread_cond_broadcast(&s->not_full);
+        pthread_mutex_unlock(&s->lock);
+
+        uint32_t out_len = 0, id;
+        memcpy(&id, job.frame + 4, 4);
+        uint32_t status = srv_solve(&job, &ws, &s->opt, &out, &out_cap, &out_len);
+        if (status == SRV_OK) srv_send(job.conn, out, out_len);
+        else srv_send_status(job.conn, id, status);
+        uint64_t lat = now_ns() - job.t_recv;
+        free(job.frame);
+
+        pthread_mutex_lock(&s->lock);
+        if (status == SRV_OK) s->latency[s->served++ % SRV_LATENCY_WINDOW] = lat;
+        else s->failed++;
+        s->held_bytes -= job.len;
+        pthread_cond_broadcast(&s->not_full);
+        pthread_mutex_unlock(&s->lock);
+        srv_conn_unref(job.conn);
+    }
+    free(out);
+    ssm_workspace_free(&ws);
+    return NULL;
+}
+
+/* Pesan slot antrean dan byte payload sebelum payload dialokasikan, jadi memori yang tertahan dibatasi
+ * SRV_QUEUE_CAP dan SRV_QUEUE_BYTES (satu frame tetap boleh lewat walau lebih besar). False jika server berhenti. */
+static bool srv_reserve(Server *s, uint32_t len) {
+    pthread_mutex_lock(&s->lock);
+    while (!s->stopping && (s->count + s->reserved >= SRV_QUEUE_CAP ||
+                            (s->held_bytes > 0 && s->held_bytes + len > SRV_QUEUE_BYTES)))
+        pthread_cond_wait(&s->not_full, &s->lock);
+    bool ok = !s->stopping;
+    if (ok) { s->reserved++; s->held_bytes += len; }
+    pthread_mutex_unlock(&s->lock);
+    return ok;
+}
+
+static void srv_unreserve(Server *s, uint32_t len) {
+    pthread_mutex_lock(&s->lock);
+    s->reserved--;
+    s->held_bytes -= len;
+    pthread_cond_broadcast(&s->not_full);
+    pthread_mutex_unlock(&s->lock);
+}
+
+/* Baca frame dari satu koneksi sampai EOF. SRV_STATS dijawab langsung; header SRV_SOLVE (m, n, panjang) dicek
+ * dulu, payload baru dialokasikan setelah slot antrean dipesan. Frame yang ditolak dilewati tanpa dialokasikan. */
+static void server_read_loop(Server *s, ServerConn *c) {
+    for (;;) {
+        uint32_t len, hdr[2];
+        int32_t dim[2];
+        if (!srv_read_full(c->in_fd, &len, 4)) break;
+        if (len < sizeof hdr) {
+            fprintf(stderr, "server: panjang frame %u tidak valid, koneksi ditutup\n", len);
+            break; // tanpa type/id tidak ada yang bisa dijawab
+        }
+        if (!srv_read_full(c->in_fd, hdr, sizeof hdr)) break;
+        size_t rest = len - sizeof hdr;
+        if (hdr[0] != SRV_SOLVE) {
+            if (!srv_skip(c->in_fd, rest)) break;
+            if (hdr[0] == SRV_STATS) srv_send_stats(s, c, hdr[1]);
+            else srv_reject(s, c, hdr[1]);
+            continue;
+        }
+        if (rest < sizeof dim) {
+            if (!srv_skip(c->in_fd, rest)) break;
+            srv_reject(s, c, hdr[1]);
+            continue;
+        }
+        if (!srv_read_full(c->in_fd, dim, sizeof dim)) break;
+        rest -= sizeof dim;
+        long long m = dim[0], n = dim[1];
+        if (m <= 0 || n <= 0 || m * n > s->max_cells ||
+            rest != (size_t)(m * n + m + n) * sizeof(int32_t)) {
+            if (!srv_skip(c->in_fd, rest)) break;
+            srv_reject(s, c, hdr[1]);
+            continue;
+        }
+        if (!srv_reserve(s, len)) break;
+        uint8_t *frame = malloc(len);
+        if (frame == NULL || !srv_read_full(c->in_fd, frame + sizeof hdr + sizeof dim, rest)) {
+            srv_unreserve(s, len);
+            if (frame == NULL && srv_skip(c->in_fd, rest)) { srv_send_status(c, hdr[1], SRV_NO_MEMORY); continue; }
+            free(frame);
+            break;
+        }
+        memcpy(frame, hdr, sizeof hdr);
+        memcpy(frame + sizeof hdr, dim, sizeof dim);
+        atomic_fetch_add(&c->refs, 1);
+        pthread_mutex_lock(&s->lock);
+        s->reserved--;
+        s->queue[(s->head + s->count) % SRV_QUEUE_CAP] = (ServerJob){ c, frame, len, now_ns() };
+        s->count++;
+        pthread_cond_signal(&s->not_empty);
+        pthread_mutex_unlock(&s->lock);
+    }
+}
+
+static ServerConn *srv_conn_new(int in_fd, int out_fd, bool owns_fds) {
+    ServerConn *c = calloc(1, sizeof *c);
+    if (c == NULL) return NULL;
+    c->in_fd = in_fd;
+    c->out_fd = out_fd;
+    c->owns_fds = owns_fds;
+    pthread_mutex_init(&c->write_lock, NULL);
+    atomic_init(&c->refs, 1); // referensi milik reader
+    atomic_init(&c->broken, false);
+    return c;
+}
+
+typedef struct {
+    Server *server;
+    ServerConn *conn;
+} ServerClient;
+
+static void *server_client_main(void *arg) {
+    ServerClient cl = *(ServerClient *)arg;
+    free(arg);
+    server_read_loop(cl.server, cl.conn);
+    srv_conn_unref(cl.conn);
+    return NULL;
+}
+
+// Mulai reader untuk satu koneksi di thread sendiri (joinable jika tid != NULL, selain itu detached)
+static bool server_spawn_client(Server *s, int fd, pthread_t *tid) {
+    ServerClient *cl = malloc(sizeof *cl);
+    ServerConn *c = cl != NULL ? srv_conn_new(fd, fd, true) : NULL;
+    pthread_t t;
+    if (c == NULL) { free(cl); close(fd); return false; }
+    *cl = (ServerClient){ s, c };
+    if (pthread_create(tid != NULL ? tid : &t, NULL, server_client_main, cl) != 0) {
+        free(cl);
+        srv_conn_unref(c);
+        return false;
+    }
+    if (tid == NULL) pthread_detach(t);
+    return true;
+}
+
+static Server *server_start(const SsmOptions *base_opt, int nworkers, long long max_cells) {
+    Server *s = calloc(1, sizeof *s);
+    if (s == NULL) return NULL;
+    s->opt = *base_opt;
+    s->opt.threads = 1; // paralelisme di level request
+    s->max_cells = max_cells > 0 ? max_cells : SRV_DEFAULT_MAX_CELLS;
+    s->t_start = now_ns();
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->not_empty, NULL);
+    pthread_cond_init(&s->not_full, NULL);
+    if (nworkers < 1) nworkers = 1;
+    s->tids = malloc((size_t)nworkers * sizeof(pthread_t));
+    for (int w = 0; s->tids != NULL && w < nworkers; w++) {
+        if (pthread_create(&s->tids[w], NULL, server_worker_main, s) != 0) break;
+        s->started++;
+    }
+    s->nworkers = s->started;
+    if (s->started == 0) {
+        fprintf(stderr, "server: gagal membuat worker\n");
+        free(s->tids);
+        free(s);
+        return NULL;
+    }
+    return s;
+}
+
+/* Worker menghabiskan antrean lalu berhenti; reader yang masih menunggu slot dilepas */
+static void server_stop(Server *s) {
+    pthread_mutex_lock(&s->lock);
+    s->stopping = true;
+    pthread_cond_broadcast(&s->not_empty);
+    pthread_cond_broadcast(&s->not_full);
+    pthread_mutex_unlock(&s->lock);
+    for (int w = 0; w < s->started; w++) pthread_join(s->tids[w], NULL);
+    free(s->tids);
+    s->tids = NULL;
+}
+
+static volatile sig_atomic_t srv_interrupted = 0;
+static void srv_on_signal(int sig) { (void)sig; srv_interrupted = 1; }
+
+/* Jalankan server sampai stdin EOF (sock_path == NULL, response ke stdout) atau SIGINT/SIGTERM (Unix socket).
+ * Request yang sudah diantrekan tetap dijawab sebelum keluar; statistik akhir ke stderr. */
+static int run_server(const char *sock_path, const SsmOptions *opt, int nworkers, long long max_cells) {
+    signal(SIGPIPE, SIG_IGN); // klien putus: write gagal dengan EPIPE, bukan proses mati
+    int lfd = -1;
+    if (sock_path != NULL) {
+        struct sockaddr_un addr = { .sun_family = AF_UNIX };
+        struct stat st;
+        if (strlen(sock_path) >= sizeof addr.sun_path) {
+            fprintf(stderr, "server: path socket terlalu panjang: %s\n", sock_path);
+            return 1;
+        }
+        strcpy(addr.sun_path, sock_path);
+        if (stat(sock_path, &st) == 0 && S_ISSOCK(st.st_mode)) unlink(sock_path); // sisa server sebelumnya
+        lfd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (lfd < 0 || bind(lfd, (struct sockaddr *)&addr, sizeof addr) != 0 || listen(lfd, 64) != 0) {
+            fprintf(stderr, "server: gagal membuka socket %s: %s\n", sock_path, strerror(errno));
+            if (lfd >= 0) close(lfd);
+            return 1;
+        }
+        struct sigaction sa = { .sa_handler = srv_on_signal }; // tanpa SA_RESTART: accept kembali dengan EINTR
+        sigaction(SIGINT, &sa, NULL);
+        sigaction(SIGTERM, &sa, NULL);
+    }
+    Server *s = server_start(opt, nworkers, max_cells);
+    if (s == NULL) {
+        if (lfd >= 0) { close(lfd); unlink(sock_path); }
+        return 1;
+    }
+    fprintf(stderr, "server: %s, %d worker, rect=%s%s, maks %lld sel\n", sock_path != NULL ? sock_path : "stdin/stdout",
+            s->started, rect_mode_names[s->opt.rect_mode], s->opt.exact ? " +exact" : "", s->max_cells);
+
+    if (sock_path == NULL) {
+        ServerConn *c = srv_conn_new(STDIN_FILENO, STDOUT_FILENO, false);
+        if (c != NULL) {
+            server_read_loop(s, c);
+            srv_conn_unref(c);
+        }
+    } else {
+        while (!srv_interrupted) {
+            int fd = accept(lfd, NULL, NULL);
+            if (fd >= 0) server_spawn_client(s, fd, NULL); // fd < 0: EINTR (sinyal) atau error sementara
+        }
+        close(lfd);
+        unlink(sock_path);
+    }
+    server_stop(s);
+    fprintf(stderr, "server: %lld request dijawab, %lld gagal, %.3f s\n", s->served, s->failed,
+            (now_ns() - s->t_start) / 1e9);
+    return 0; // s tidak dibebaskan: reader socket yang ter-detach mungkin masih memegangnya
+}
+
+/* Uji round-trip protokol lewat socketpair: server dan klien di proses yang sama. Klien mengirim semua
+ * testcase (pipelined) lalu request yang harus ditolak, kemudian stats. Dicek: status, cost sama dengan
+ * solve_instance biasa, alokasi memenuhi supply/demand, id, dan isi stats. */
+static bool srv_test_frame(int fd, uint32_t type, uint32_t id, const int32_t *body, size_t count) {
+    uint32_t head[3] = { (uint32_t)(8 + count * 4), type, id };
+    return srv_write_full(fd, head, sizeof head) && (count == 0 || srv_write_full(fd, body, count * 4));
+}
+
+static uint8_t *srv_test_response(int fd, uint32_t *len) {
+    if (!srv_read_full(fd, len, 4) || *len < 8) return NULL;
+    uint8_t *p = malloc(*len + 1);
+    if (p != NULL && !srv_read_full(fd, p, *len)) { free(p); return NULL; }
+    if (p != NULL) p[*len] = '\0';
+    return p;
+}
+
+static int run_server_selftest(const SsmOptions *opt) {
+    enum { MAX_CASES = 40 };
+    SsmInstance inst[MAX_CASES];
+    int32_t *body[MAX_CASES];
+    long long expect[MAX_CASES];
+    int ncase = 0, failures = 0;
+    SsmWorkspace ws = { 0 };
+    SsmOptions o = *opt;
+    o.threads = 1;
+    for (int k = 1; k <= 35 && ncase < MAX_CASES; k++) {
+        char filename[20];
+        sprintf(filename, "testcase/n%02d.txt", k);
+        SsmInstance in;
+        if (access(filename, R_OK) != 0 || !load_instance(filename, &ws, &o, &in)) continue;
+        long long tot = 0;
+        for (int i = 0; i < in.m; i++) tot += in.supply[i];
+        for (int j = 0; j < in.n; j++) tot -= in.demand[j];
+        if (tot < 0) { instance_release(&in); continue; } // server menolak supply < demand
+        size_t mn = (size_t)in.m * in.n, cnt = 2 + mn + in.m + in.n;
+        body[ncase] = malloc(cnt * sizeof(int32_t));
+        body[ncase][0] = in.m; body[ncase][1] = in.n;
+        memcpy(body[ncase] + 2, in.cost, mn * sizeof(int));
+        memcpy(body[ncase] + 2 + mn, in.supply, (size_t)in.m * sizeof(int));
+        memcpy(body[ncase] + 2 + mn + in.m, in.demand, (size_t)in.n * sizeof(int));
+        expect[ncase] = solve_instance(&in, &ws, &o);
+        inst[ncase] = (SsmInstance){ in.m, in.n, body[ncase] + 2, body[ncase] + 2 + mn, body[ncase] + 2 + mn + in.m, NULL, 0 };
+        instance_release(&in);
+        ncase++;
+    }
+    ssm_workspace_free(&ws);
+
+    int sv[2];
+    signal(SIGPIPE, SIG_IGN);
+    if (ncase == 0 || socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+        printf("Selftest server: tidak ada testcase atau socketpair gagal\n");
+        return 1;
+    }
+    Server *s = server_start(opt, 2, 0);
+    pthread_t reader;
+    if (s == NULL || !server_spawn_client(s, sv[0], &reader)) { close(sv[1]); return 1; }
+
+    // Request buruk: supply negatif, supply < demand, ukuran tidak cocok, m*n melebihi batas, type tidak dikenal
+    int32_t neg[] = { 2, 2, 1, 2, 3, 4, -5, 15, 5, 5 }, unbal[] = { 2, 2, 1, 2, 3, 4, 3, 3, 5, 5 };
+    int32_t shortb[] = { 2, 2, 1, 2, 3 }, huge[] = { 1 << 15, 1 << 15 };
+    uint32_t nbad = 5, nreq = (uint32_t)ncase + nbad;
+    bool sent = true;
+    for (int k = 0; k < ncase; k++)
+        sent = sent && srv_test_frame(sv[1], SRV_SOLVE, (uint32_t)k, body[k],
+                                      2 + (size_t)inst[k].m * inst[k].n + inst[k].m + inst[k].n);
+    sent = sent && srv_test_frame(sv[1], SRV_SOLVE, 1000, neg, 10) && srv_test_frame(sv[1], SRV_SOLVE, 1001, unbal, 10) &&
+           srv_test_frame(sv[1], SRV_SOLVE, 1002, shortb, 5) && srv_test_frame(sv[1], SRV_SOLVE, 1003, huge, 2) &&
+           srv_test_frame(sv[1], 77, 1004, NULL, 0);
+    bool *seen = calloc(nreq, sizeof(bool));
+    for (uint32_t r = 0; sent && r < nreq; r++) {
+        uint32_t len, id, status;
+        uint8_t *p = srv_test_response(sv[1], &len);
+        if (p == NULL) { printf("Selftest server: response %u tidak terbaca\n", r); failures++; break; }
+        memcpy(&id, p, 4);
+        memcpy(&status, p + 4, 4);
+        if (id >= 1000 && id < 1000 + nbad) {
+            if (status != SRV_BAD_REQUEST || seen[ncase + id - 1000]) { printf("  id %u: status %u, harusnya ditolak\n", id, status); failures++; }
+            else seen[ncase + id - 1000] = true;
+        } else if (id < (uint32_t)ncase && !seen[id] && status == SRV_OK && len >= 20) {
+            const SsmInstance *in = &inst[id];
+            long long cost, sum = 0;
+            uint32_t cells;
+            memcpy(&cost, p + 8, 8);
+            memcpy(&cells, p + 16, 4);
+            int *row = calloc((size_t)in->m, sizeof(int)), *col = calloc((size_t)in->n, sizeof(int));
+            bool ok = len == 20 + 12 * (size_t)cells;
+            for (uint32_t t = 0; ok && t < cells; t++) {
+                int32_t cell[3];
+                memcpy(cell, p + 20 + 12 * (size_t)t, sizeof cell);
+                ok = cell[0] >= 0 && cell[0] < in->m && cell[1] >= 0 && cell[1] < in->n && cell[2] > 0;
+                if (!ok) break;
+                row[cell[0]] += cell[2];
+                col[cell[1]] += cell[2];
+                sum += (long long)in->cost[(size_t)cell[0] * in->n + cell[1]] * cell[2];
+            }
+            for (int i = 0; ok && i < in->m; i++) ok = row[i] <= in->supply[i];
+            for (int j = 0; ok && j < in->n; j++) ok = col[j] == in->demand[j];
+            ok = ok && sum == cost && cost == expect[id];
+            if (!ok) { printf("  id %u: alokasi/cost salah (cost %lld, harusnya %lld)\n", id, cost, expect[id]); failures++; }
+            seen[id] = true;
+            free(row); free(col);
+        } else {
+            printf("  id %u: response tidak terduga (status %u)\n", id, status);
+            failures++;
+        }
+        free(p);
+    }
+    for (uint32_t r = 0; r < nreq; r++) if (!seen[r]) { printf("  request %u tanpa response\n", r); failures++; }
+
+    // Stats dijawab reader setelah semua response di atas terbaca, jadi hitungannya sudah final
+    uint32_t len;
+    char *stats = NULL;
+    if (sent && srv_test_frame(sv[1], SRV_STATS, 4242, NULL, 0)) stats = (char *)srv_test_response(sv[1], &len);
+    long long served = -1, failed = -1;
+    uint32_t id = 0;
+    if (stats != NULL) {
+        memcpy(&id, stats, 4);
+        const char *js = stats + 8, *a = strstr(js, "\"served\":"), *b = strstr(js, "\"failed\":");
+        if (a != NULL) served = atoll(a + 9);
+        if (b != NULL) failed = atoll(b + 9);
+        printf("stats: %s\n", js);
+    }
+    if (!sent || id != 4242 || served != ncase || failed != (long long)nbad || stats == NULL || strstr(stats + 8, "\"p99_us\":") == NULL) {
+        printf("  stats salah: served %lld (harusnya %d), failed %lld (harusnya %u)\n", served, ncase, failed, nbad);
+        failures++;
+    }
+    free(stats);
+    close(sv[1]);
+    pthread_join(reader, NULL);
+    server_stop(s);
+    pthread_mutex_destroy(&s->lock);
+    pthread_cond_destroy(&s->not_empty);
+    pthread_cond_destroy(&s->not_full);
+    free(s);
+    free(seen);
+    for (int k = 0; k < ncase; k++) free(body[k]);
+    printf("Selftest server: %d solve, %u request ditolak, %s\n", ncase, nbad, failures == 0 ? "SEMUA BENAR" : "GAGAL");
+    return failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    SsmOptions opt = default_options;
+    int bench_max = 0;
+    bool bench_seeds = false;
+    int bench_harness_max = 0;
+    int warm_bench_size = 0;
+    const char *batch_src = NULL;
+    const char *scenario_path = NULL;
+    int scenario_bench_size = 0;
+    size_t pair_diff_cap = (size_t)PAIR_DIFF_DEFAULT_MB << 20;
+    int portfolio = 0;
+    int pivot_bench_size = 0;
+    bool serve = false;
+    const char *serve_path = NULL;
+    long long serve_max_cells = SRV_DEFAULT_MAX_CELLS;
+    bool serve_selftest = false;
+    bool threads_given = false;
+    const char *trace_path = NULL;
+    size_t trace_ring = 0;
+    const char **paths = malloc((size_t)argc * sizeof(char *));
+    int npaths = 0;
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--rect=exhaustive") == 0) opt.rect_mode = RECT_SEARCH_EXHAUSTIVE;
+        else if (strcmp(argv[a], "--rect=scan") == 0) opt.rect_mode = RECT_SEARCH_SCAN;
+        else if (strcmp(argv[a], "--rect=incremental") == 0) opt.rect_mode = RECT_SEARCH_INCREMENTAL;
+        else if (strcmp(argv[a], "--rect=verify") == 0) opt.rect_mode = RECT_SEARCH_VERIFY;
+        else if (strcmp(argv[a], "--rect=sparse") == 0) opt.rect_mode = RECT_SEARCH_SPARSE;
+        else if (strncmp(argv[a], "--threads=", 10) == 0) {
+            opt.threads = atoi(argv[a] + 10);
+            threads_given = true;
+            if (opt.threads <= 0) opt.threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+            if (opt.threads <= 0) opt.threads = 1;
+        }
+        else if (strcmp(argv[a], "--exact") == 0) opt.exact = true;
+        else if (strcmp(argv[a], "--feas-scan=sorted") == 0) opt.feas_scan = FEAS_SCAN_SORTED;
+        else if (strcmp(argv[a], "--feas-scan=simd") == 0) opt.feas_scan = FEAS_SCAN_SIMD;
+        else if (strncmp(argv[a], "--seed=", 7) == 0) {
+            size_t s = 0, ns = sizeof seed_strategies / sizeof seed_strategies[0];
+            while (s < ns && strcmp(argv[a] + 7, seed_strategies[s].name) != 0) s++;
+            if (s == ns) {
+                fprintf(stderr, "Seed tidak dikenal: %s (ssm|least-cost|vogel|russell)\n", argv[a] + 7);
+                return 1;
+            }
+            opt.seed = seed_strategies[s].id;
+        }
+        else if (strcmp(argv[a], "--flc=first") == 0) opt.flc_rule = FLC_FIRST;
+        else if (strcmp(argv[a], "--flc=costliest") == 0) opt.flc_rule = FLC_COSTLIEST;
+        else if (strncmp(argv[a], "--improve=", 10) == 0) {
+            int r = 0, nr = (int)(sizeof pivot_rule_names / sizeof pivot_rule_names[0]);
+            while (r < nr && strcmp(argv[a] + 10, pivot_rule_names[r]) != 0) r++;
+            if (r == nr) {
+                fprintf(stderr, "Aturan pivot tidak dikenal: %s (best|first|list|block)\n", argv[a] + 10);
+                return 1;
+            }
+            opt.pivot = (RectPivotRule)r;
+        }
+        else if (strncmp(argv[a], "--improve-k=", 12) == 0) opt.pivot_k = atoi(argv[a] + 12);
+        else if (strncmp(argv[a], "--improve-block=", 16) == 0) opt.pivot_block = atoi(argv[a] + 16);
+        else if (strncmp(argv[a], "--tie-seed=", 11) == 0) opt.tie_seed = strtoull(argv[a] + 11, NULL, 10);
+        else if (strcmp(argv[a], "--portfolio") == 0) portfolio = -1;
+        else if (strncmp(argv[a], "--portfolio=", 12) == 0) portfolio = atoi(argv[a] + 12);
+        else if (strcmp(argv[a], "--bench-seeds") == 0) bench_seeds = true;
+        else if (strcmp(argv[a], "--serve") == 0) serve = true;
+        else if (strncmp(argv[a], "--serve=", 8) == 0) { serve = true; serve_path = argv[a] + 8; }
+        else if (strncmp(argv[a], "--serve-max-cells=", 18) == 0) serve_max_cells = atoll(argv[a] + 18);
+        else if (strcmp(argv[a], "--serve-selftest") == 0) serve_selftest = true;
+        else if (strcmp(argv[a], "--pivot-bench") == 0) pivot_bench_size = 200;
+        else if (strncmp(argv[a], "--pivot-bench=", 14) == 0) pivot_bench_size = atoi(argv[a] + 14);
+        else if (strcmp(argv[a], "--bench") == 0) bench_harness_max = 2000;
+        else if (strcmp(argv[a], "--batch") == 0 && a + 1 < argc) batch_src = argv[++a];
+        else if (strcmp(argv[a], "--scenarios") == 0 && a + 1 < argc) scenario_path = argv[++a];
+        else if (strcmp(argv[a], "--scenario-bench") == 0) scenario_bench_size = 200;
+        else if (strncmp(argv[a], "--scenario-bench=", 17) == 0) scenario_bench_size = atoi(argv[a] + 17);
+        else if (strncmp(argv[a], "--pair-diff-mb=", 15) == 0) pair_diff_cap = (size_t)strtoull(argv[a] + 15, NULL, 10) << 20;
+        else if (strncmp(argv[a], "--bench=", 8) == 0) bench_harness_max = atoi(argv[a] + 8);
+        else if (strcmp(argv[a], "--warm-bench") == 0) warm_bench_size = 200;
+        else if (strncmp(argv[a], "--warm-bench=", 13) == 0) warm_bench_size = atoi(argv[a] + 13);
+        else if (strcmp(argv[a], "--quiet") == 0) log_steps = false;
+        else if (strncmp(argv[a], "--time-limit=", 13) == 0) opt.time_limit_ms = atof(argv[a] + 13);
+        else if (strncmp(argv[a], "--work-budget=", 14) == 0) opt.work_budget = atoll(argv[a] + 14);
+        else if (strncmp(argv[a], "--trace=", 8) == 0) trace_path = argv[a] + 8;
+        else if (strncmp(argv[a], "--trace-ring=", 13) == 0) trace_ring = (size_t)strtoull(argv[a] + 13, NULL, 10);
+        else if (strcmp(argv[a], "--trace-dump") == 0 && a + 1 < argc) return trace_dump(argv[a + 1]);
+        else if (strcmp(argv[a], "--bench-kernels") == 0) return run_kernel_benchmark(4096);
+        else if (strncmp(argv[a], "--bench-kernels=", 16) == 0) return run_kernel_benchmark(atoi(argv[a] + 16));
+        else if (strcmp(argv[a], "--bench-scale") == 0) bench_max = 5000;
+        else if (strncmp(argv[a], "--bench-scale=", 14) == 0) bench_max = atoi(argv[a] + 14);
+        else if (strcmp(argv[a], "--convert") == 0 && a + 2 < argc) return convert_to_bin(argv[a + 1], argv[a + 2]);
+        else if (strcmp(argv[a], "--convert-csr") == 0 && a + 3 < argc)
+            return convert_to_csr(argv[a + 1], argv[a + 2], atoi(argv[a + 3]));
+        else if (strcmp(argv[a], "--parse-bench") == 0 && a + 1 < argc) return run_parse_benchmark(argv[a + 1]);
+        else if (argv[a][0] != '-') paths[npaths++] = argv[a];
+        else {
+            fprintf(stderr, "Opsi tidak dikenal: %s\n", argv[a]);
+            fprintf(stderr, "Pemakaian: %s [--rect=exhaustive|scan|incremental|sparse|verify] [--threads=N] [--exact] [--feas-scan=sorted|simd]\n"
+                            "          [--seed=ssm|least-cost|vogel|russell] [--time-limit=MS] [--work-budget=N] [--quiet] [--trace=FILE [--trace-ring=N]]\n"
+                            "          [--flc=first|costliest] [--improve=best|first|list|block [--improve-k=K] [--improve-block=B]] [--tie-seed=S] [--portfolio[=N]]\n"
+                            "          [--bench[=MAX]] [--bench-scale[=MAX]] [--bench-seeds] [--pivot-bench[=SIZE]] [--warm-bench[=SIZE]]\n"
+                            "          [--serve[=SOCKET] [--serve-max-cells=N]] [--serve-selftest] [--batch DIR|MANIFEST] [--scenarios FILE [--pair-diff-mb=N]] [--scenario-bench[=SIZE]] [FILE...]\n"
+                            "          %s --convert IN.txt OUT.bin | --convert-csr IN OUT.csr FORBID | --parse-bench FILE.txt\n"
+                            "          %s --bench-kernels[=M] | --trace-dump FILE\n", argv[0], argv[0], argv[0]);
+            return 1;
+        }
+    }
+    if (bench_max > 0) return run_scaling_benchmark(bench_max, &opt);
+    if (bench_seeds) return run_seed_benchmark(&opt);
+    if (pivot_bench_size > 0) return run_pivot_benchmark(pivot_bench_size, &opt);
+    if (bench_harness_max > 0) return run_bench_harness(bench_harness_max, &opt);
+    if (warm_bench_size > 0) return run_warm_benchmark(warm_bench_size, &opt);
+    if (scenario_bench_size > 0) return run_scenario_benchmark(scenario_bench_size, 32, &opt);
+    if (portfolio != 0 && (batch_src != NULL || scenario_path != NULL || serve)) {
+        fprintf(stderr, "--portfolio tidak bisa digabung dengan --batch, --scenarios atau --serve\n");
+        free(paths);
+        return 1;
+    }
+    if (serve_selftest) {
+        log_steps = false;
+        free(paths);
+        return run_server_selftest(&opt);
+    }
+    if (serve) {
+        // stdout bisa jadi kanal response biner: semua log mati, pesan server ke stderr
+        log_steps = false;
+        int workers = threads_given ? opt.threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        int rc = run_server(serve_path, &opt, workers, serve_max_cells);
+        free(paths);
+        return rc;
+    }
+    if (scenario_path != NULL) {
+        // Seperti batch: skenario dikerjakan paralel, log langkah dimatikan
+        bool print_alloc = log_steps;
+        log_steps = false;
+        int workers = threads_given ? opt.threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        int rc = run_scenarios_file(scenario_path, &opt, workers, pair_diff_cap, print_alloc);
+        free(paths);
+        return rc;
+    }
+    if (batch_src != NULL) {
+        // Worker mengisi buffer per task; log langkah (printf langsung) tidak aman dari banyak thread
+        log_steps = false;
+        int workers = threads_given ? opt.threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+        int rc = run_batch(batch_src, &opt, workers);
+        free(paths);
+        return rc;
+    }
+
+    if (portfolio != 0) {
+        // Default satu varian per core, minimal 4 agar semua kombinasi aturan deterministik ikut jalan
+        if (portfolio < 0) {
+            portfolio = (int)sysconf(_SC_NPROCESSORS_ONLN);
+            if (portfolio < 4) portfolio = 4;
+        }
+        log_steps = false; // varian berjalan di banyak thread
+    }
+
+    SsmWorkspace ws = { 0 };
+    TraceSink trace = { 0 };
+    if (trace_path != NULL) {
+        if (!trace_open(&trace, trace_path, trace_ring)) {
+            fprintf(stderr, "Gagal membuka file trace %s\n", trace_path);
+            free(paths);
+            return 1;
+        }
+        ws.trace = &trace;
+    }
+
+    int sudah_optimal[36] = {0};  
+    int total_optimal = 0, total_belum = 0, total_diproses = 0;
+
+    // File instance eksplisit (teks, biner atau sparse CSR) menggantikan daftar testcase/nXX.txt
+    if (npaths > 0) {
+        for (int k = 0; k < npaths; k++) {
+            SsmInstance inst;
+            printf("\n\n################################################################\n");
+            printf("### PROCESSING FILE: %s\n", paths[k]);
+            printf("################################################################\n");
+            if (is_sparse_file(paths[k])) {
+                // Satu worker per komponen terhubung; default semua core online
+                int workers = threads_given ? opt.threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+                sparse_warn_ignored(&opt, ws.trace != NULL, portfolio);
+                if (run_sparse_file(paths[k], workers) == 0) total_diproses++;
+                printf("================================================================\n");
+                continue;
+            }
+            if (!load_instance(paths[k], &ws, &opt, &inst)) {
+                printf("Gagal membaca instance %s, file dilewati.\n", paths[k]);
+                continue;
+            }
+            long long tot = portfolio > 0 ? solve_portfolio(&inst, &ws, &opt, portfolio, pair_diff_cap)
+                                          : solve_instance(&inst, &ws, &opt);
+            printf("\n>>> Total Transportation Cost (final) : %lld\n", tot);
+            print_early_stop(stdout, &ws.metrics);
+            print_metrics_json(stdout, paths[k], &inst, &opt, &ws.metrics);
+            printf("================================================================\n");
+            instance_release(&inst);
+            total_diproses++;
+        }
+        printf("\nTotal file yang diproses : %d dari %d\n", total_diproses, npaths);
+        free(paths);
+        ssm_workspace_free(&ws);
+        bool trace_ok = trace_close(&trace);
+        if (!trace_ok) fprintf(stderr, "Gagal menulis file trace %s: isinya tidak lengkap\n", trace_path);
+        return total_diproses == npaths && trace_ok ? 0 : 1;
+    }
+
+    for (int k = 1; k <= 35; k++) {
+        if (optimal_solution[k] == -1) continue;
+        char filename[20];
+        sprintf(filename, "testcase/n%02d.txt", k);
+
+        if (access(filename, R_OK) != 0) {
+            continue;
+        }
+        
+        printf("\n\n################################################################\n");
+        printf("### PROCESSING FILE: %s\n", filename);
+        printf("################################################################\n");
+
+        SsmInstance inst;
+        if (!load_instance(filename, &ws, &opt, &inst)) {
+            printf("Gagal membaca instance %s, file dilewati.\n", filename);
+            continue;
+        }
+
+        long long tot = portfolio > 0 ? solve_portfolio(&inst, &ws, &opt, portfolio, pair_diff_cap)
+                                      : solve_instance(&inst, &ws, &opt);
+        printf("\n>>> Total Transportation Cost (final) : %lld\n", tot);
+        print_early_stop(stdout, &ws.metrics);
+        print_metrics_json(stdout, filename, &inst, &opt, &ws.metrics);
+        instance_release(&inst);
+
+        if (tot == (long long)optimal_solution[k]) {
+            printf(">>> Status: OPTIMAL (sesuai nilai yang diharapkan %d)\n", optimal_solution[k]);
+            sudah_optimal[k] = 1;
+            total_optimal++;
+        } else {
+            printf(">>> Status: BELUM OPTIMAL (seharusnya %d, diperoleh %lld)\n", optimal_solution[k], tot);
+            sudah_optimal[k] = 0;
+            total_belum++;
+        }
+        total_diproses++;
+        printf("================================================================\n");
+    }
+
+    printf("\n====================== SUMMARY ======================\n");
+    printf(" Total file yang diproses : %d\n", total_diproses);
+    printf(" Total optimal         : %d\n", total_optimal);
+    printf(" Total belum optimal   : %d\n", total_belum);
+    if (total_diproses > 0) {
         double persen = (100.0 * total_optimal) / (double) total_diproses;
         printf(" Persentase optimal    : %.2f%%\n", persen);
     }
@@ -533,5 +5933,11 @@ int main(void)
         if (optimal_solution[k] != -1 && sudah_optimal[k] == 0)
             printf("N%02d ", k);
     printf("\n=====================================================\n");
+    free(paths);
+    ssm_workspace_free(&ws);
+    if (!trace_close(&trace)) {
+        fprintf(stderr, "Gagal menulis file trace %s: isinya tidak lengkap\n", trace_path);
+        return 1;
+    }
     return 0;
 }